@@ -1,10 +1,11 @@
+#define _GNU_SOURCE    // posix_openpt, ptsname_r
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>    // fork, execvp, sleep
 #include <fcntl.h>     // O_CREAT, O_EXCL, O_RDWR
 #include <sys/mman.h>  // shm_open, mmap, shm_unlink, munmap
-#include <sys/stat.h>  // 0666
+#include <sys/stat.h>  // 0600
 #include <semaphore.h> // sem_open, sem_wait, sem_post, sem_close, sem_unlink
 #include <sys/msg.h>   // msgget, msgsnd, msgrcv
 #include <sys/types.h> // pid_t, key_t
@@ -13,13 +14,71 @@
 #include <signal.h>    // kill, SIGTERM
 #include <pthread.h>   // pthread_create, pthread_join
 #include <sys/wait.h>  // waitpid, WNOHANG
+#include <sys/resource.h> // wait4, struct rusage
 #include <fcntl.h>     // pipe, open
+#include <sched.h>     // sched_yield
+#include <poll.h>      // poll
+#include <sys/socket.h> // socket, accept (attach soketi)
+#include <sys/un.h>    // sockaddr_un
+#include <sys/ioctl.h> // TIOCSCTTY, TIOCSWINSZ
+#include <termios.h>   // tcgetattr, cfmakeraw
+#include <dirent.h>    // opendir (domain listesi)
+#include <stddef.h>    // offsetof
+#ifdef __linux__
+#include <sys/syscall.h> // SYS_ioprio_set
+#else
+extern char **environ; // Linux'ta _GNU_SOURCE ile unistd.h bildirir
+#endif
 
-#define SHM_NAME "/procx_shm"
-#define SEM_NAME "/procx_sem"
-#define IPC_KEY_FILE "/tmp/procx_ipc_key"
+// IPC kaynak adları kullanıcı ve domain'e göre ayrılır (%u: uid, %s: domain)
+#define SHM_NAME_FMT "/procx_shm.%u.%s"
+#define SEM_NAME_FMT "/procx_sem.%u.%s"
+#define PRIVATE_DIR_FMT "/tmp/procx-%u" // Kullanıcıya özel 0700 dizin: anahtar dosyaları ve attach soketleri
+#define IPC_KEY_PREFIX "ipc_key." // Anahtar dosyası: <özel dizin>/ipc_key.<domain>
+#define IPC_MODE 0600 // Kaynaklara yalnızca sahibi erişebilir
+#define DOMAIN_ENV "PROCX_DOMAIN" // --domain verilmezse kullanılan domain
+#define DEFAULT_DOMAIN "default"
+#define MAX_DOMAIN_LEN 31
+#define TOP_MAX_ROWS 256 // procx top'un çizdiği en fazla satır
+#define TOP_MAX_COLS 512 // procx top'un çizdiği en fazla sütun
 #define MAX_PROCESSES 50
+#define MAX_INSTANCES 32 // Bir domain'de aynı anda çalışabilecek instance (mesaj alıcısı) sayısı
 #define MAX_ARGS 10 // Bir komut için maksimum argüman sayısı
+#define MAX_HISTORY 32 // Sonlanan process geçmişinde tutulan kayıt sayısı
+#define MAX_WATCHES (4 * MAX_PROCESSES + 1) // Event loop'un izlediği maksimum fd sayısı (exec + bildirim + PTY + attach istemcisi + dinleme soketi)
+#define SPAWNER_THREADS 4 // Paralel fork/exec yapan thread sayısı
+#define SPAWN_QUEUE_SIZE 64 // Bekleyebilecek maksimum başlatma isteği
+#define MAX_SCHEDULES 32768 // Shared memory'de saklanan maksimum zamanlanmış görev (~15 MB, sayfalar kullanıldıkça ayrılır)
+#define SCHEDULE_LOG_SIZE 256 // Zamanlayıcının tek tek işleyebileceği bekleyen görev değişikliği sayısı
+#define WHEEL_LEVELS 4 // Timer wheel seviye sayısı (64^4 saniye ~ 194 gün kapsar)
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS) // Seviye başına slot sayısı
+#define NOTIFY_ENV "PROCX_NOTIFY_FD" // Child'a hazır bildirimi fd'sini ileten ortam değişkeni
+#define RUN_ARGS_SIZE 1024 // procx run isteğindeki argv'nin toplam boyutu (NUL'ler dahil)
+#define RUN_MAX_ARGS 64 // procx run isteğindeki en fazla argüman
+#define RUN_REPLY_TIMEOUT_MS 10000 // procx run'ın instance'tan cevap bekleme süresi
+#define MSG_RUN_REQUEST 100 // Message.command: procx run isteği (RunRequest)
+#define MSG_RUN_REPLY 101 // Message.command: procx run isteğinin sonucu
+#define WAIT_STATUS_UNKNOWN 255 // procx wait: process sonlandı ama çıkış durumu bilinmiyor
+#define ATTACH_SOCK_PREFIX "attach."
+#define ATTACH_SOCK_FMT "%s/" ATTACH_SOCK_PREFIX "%d.sock" // Instance başına attach soketi (%s: özel dizin, %d: instance PID'si)
+#define SCROLLBACK_SIZE 16384 // PTY başına saklanan son çıktı (bayt)
+#define DETACH_KEY 0x1d // Ctrl-]: attach'tan ayrılma tuşu
+#define PSI_ENV "PROCX_PSI" // Baskı eşiklerini ayarlayan ortam değişkeni
+#define PSI_RESOURCES 3 // cpu, memory, io
+#define PSI_WINDOW_US 2000000 // PSI trigger penceresi (yetkisiz kullanıcılar için 2 saniyenin katı olmalı)
+#define PSI_HOLD_SEC 4 // Son tetiklenmeden bu kadar saniye sonra baskı geçmiş sayılır
+#define NOTICE_ENV "PROCX_NOTICES" // Bildirim birleştirme ve hız sınırı ayarları
+#define NOTICE_BUCKETS 16 // Bir pencerede ayrı tutulan (tür, sahip) grubu sayısı
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // macOS: yerine SO_NOSIGPIPE kullanılır
+#endif
+
+// ioprio_set için sabitler (glibc bunlar için header sağlamıyor)
+#define IOPRIO_WHO_PROCESS 1
+#define IOPRIO_CLASS_SHIFT 13
+#define IOPRIO_PRIO_VALUE(cls, lvl) (((cls) << IOPRIO_CLASS_SHIFT) | (lvl))
 
 // Enum
 typedef enum
@@ -32,10 +91,45 @@ typedef enum
 {
     STATUS_RUNNING = 0,
     STATUS_TERMINATED = 1,
-    STATUS_CREATED = 2
+    STATUS_CREATED = 2,
+    STATUS_STARTING = 3 // exec edildi, READY=1 bildirimi bekleniyor
 } ProcessStatus;
 
+typedef enum
+{
+    IOPRIO_CLASS_NONE = 0, // Değiştirme (ProcX'ten miras al)
+    IOPRIO_CLASS_RT = 1,   // Realtime (root gerektirir)
+    IOPRIO_CLASS_BE = 2,   // Best-effort
+    IOPRIO_CLASS_IDLE = 3  // Yalnızca disk boştayken
+} IoPrioClass;
+
+typedef enum
+{
+    TOP_SORT_RUNTIME = 0, // En uzun çalışan önce
+    TOP_SORT_OWNER = 1,
+    TOP_SORT_MODE = 2,
+    TOP_SORT_PID = 3
+} TopSortKey;
+
 // Veri Yapıları
+
+// Child'a exec öncesi uygulanan kaynak sınırları ve öncelikler.
+// Sıfır olan alanlar değiştirilmez, child ProcX'in değerlerini miras alır.
+typedef struct
+{
+    char profile[16];     // Profil adı (yalnızca açık seçenek verildiyse "custom", profili değiştirdiyse "ad+")
+    int nice;             // setpriority değeri (-20..19)
+    IoPrioClass ioprio_class;
+    int ioprio_level;     // 0 (en yüksek) .. 7 (en düşük)
+    int oom_score_adj;    // -1000..1000
+    long mem_limit_mb;    // RLIMIT_AS
+    long nofile_limit;    // RLIMIT_NOFILE
+    long cpu_limit_sec;   // RLIMIT_CPU (aşılınca SIGXCPU)
+    int notify_ready;     // 1 ise child READY=1 yazana kadar STATUS_STARTING'de kalır
+    int ready_timeout_sec; // --notify: READY=1 gelmezse bu süre sonunda Running sayılır
+    int use_pty;          // 1 ise child'ın stdin/stdout/stderr'i bir PTY'ye bağlanır (procx attach)
+} LaunchOptions;
+
 typedef struct
 {
     pid_t pid;            // Process ID
@@ -45,59 +139,583 @@ typedef struct
     ProcessStatus status; // Running (0) veya Terminated (1)
     time_t start_time;    // Başlangıç zamanı
     int is_active;
+    LaunchOptions launch; // Uygulanan sınırlar ve öncelikler
+    struct timespec start_mono; // fork öncesi CLOCK_MONOTONIC (gecikme ölçümü için)
+    long ready_latency_ms;      // Başlatmadan READY=1'e kadar geçen süre (-1: yok/bekleniyor)
+    unsigned int launch_id;     // Yer ayırma anahtarı (kayıtlar kaydırıldığı için index kullanılamaz)
+    unsigned int schedule_id;   // Başlatan zamanlanmış görev (0: elle başlatıldı)
 } ProcessInfo;
 
+typedef enum
+{
+    SCHED_ONESHOT = 0,    // Belirli bir süre sonra / saatte bir kez
+    SCHED_FIXED_RATE = 1, // Her N saniyede bir
+    SCHED_CRON = 2        // Cron ifadesine göre
+} ScheduleKind;
+
+// Ayrıştırılmış cron ifadesi (her alan bir bit maskesi)
+typedef struct
+{
+    unsigned long long minutes; // 0-59
+    unsigned int hours;         // 0-23
+    unsigned int days;          // 1-31
+    unsigned short months;      // 1-12
+    unsigned char weekdays;     // 0-6 (0: Pazar)
+    unsigned char dom_restricted;
+    unsigned char dow_restricted;
+} CronSpec;
+
+// Zamanlanmış görev (shared memory'de saklanır, instance kapansa da kaybolmaz)
+typedef struct
+{
+    int in_use;
+    unsigned int id;        // Kullanıcıya gösterilen görev numarası
+    ScheduleKind kind;
+    char command[256];      // Çalıştırılacak komut
+    ProcessMode mode;
+    LaunchOptions opts;     // Her çalıştırmada uygulanan sınırlar
+    long interval_sec;      // SCHED_FIXED_RATE aralığı
+    char cron_expr[64];     // SCHED_CRON ifadesi (gösterim için)
+    CronSpec cron;
+    int skip_if_running;    // Önceki çalıştırma sürüyorsa bu turu atla
+    time_t next_run;        // Bir sonraki çalışma zamanı
+    unsigned int run_count; // Başlatılan çalıştırma sayısı
+    unsigned int skip_count; // Atlanan çalıştırma sayısı
+    pid_t last_pid;         // Son başlatılan process
+    pid_t creator_pid;      // Görevi ekleyen process
+} ScheduleInfo;
+
+// Sonlanan bir process'in kaydı (geçmiş halkasında tutulur)
+typedef struct
+{
+    pid_t pid;            // Process ID
+    pid_t owner_pid;      // Başlatan instance'ın PID'si
+    char command[256];    // Çalıştırılan komut
+    ProcessMode mode;     // Attached (0) veya Detached (1)
+    time_t start_time;    // Başlangıç zamanı
+    time_t end_time;      // Sonlanma zamanı
+    int status_known;     // wait4 ile toplandıysa 1, başka instance'ın process'i ise 0
+    int exit_code;        // Normal çıkışta çıkış kodu, aksi halde -1
+    int term_signal;      // Process'i sonlandıran sinyal (0: sinyal yok)
+    long user_time_ms;    // Kullanıcı modunda harcanan CPU süresi
+    long sys_time_ms;     // Kernel modunda harcanan CPU süresi
+    long max_rss_kb;      // Maksimum resident set size
+} ExitRecord;
+
+// Baskıya göre kabul kontrolünün sayaçları (tüm instance'ların toplamı)
+typedef struct
+{
+    unsigned int deferred_total;  // Baskı yüzünden ertelenen istekler (Detached önce)
+    unsigned int throttled_total; // Hız sınırına takılıp bekletilen istekler
+    unsigned int resumed_total;   // Bekledikten sonra başlatılan istekler
+    unsigned int dropped_total;   // Erteleme kuyruğu dolu olduğu için düşürülen istekler
+    int waiting;                  // Şu an bekleyen istek sayısı
+    unsigned int pressure_mask;   // Eşiği aşan kaynaklar (bit 0: cpu, 1: memory, 2: io)
+    time_t last_pressure;         // Son eşik aşımı zamanı
+} AdmissionStats;
+
 typedef struct
 {
+    unsigned int seq;                     // Seqlock sayacı (tek: yazma sürüyor, çift: tutarlı)
     ProcessInfo processes[MAX_PROCESSES]; // Maksimum 50 process
     int process_count;                    // Aktif process sayısı
     int instance_count;                   // Aktif ProcX instance sayısı
+    pid_t instance_pids[MAX_INSTANCES];   // Aktif instance'lar (ilk instance_count kadarı, mesaj alıcıları)
+    ExitRecord history[MAX_HISTORY];      // Sonlanan process'ler (dairesel)
+    unsigned int history_total;           // Şimdiye kadar yazılan kayıt sayısı
+    unsigned int next_launch_id;          // Son verilen launch_id
+    unsigned int schedule_gen;            // Görev eklenip silindikçe artar
+    int schedule_log[SCHEDULE_LOG_SIZE];  // Değişen görev indexleri (schedule_gen % SCHEDULE_LOG_SIZE'a yazılır)
+    int schedule_high;                    // Şimdiye kadar kullanılan en yüksek görev indexi + 1
+    unsigned int next_schedule_id;        // Son verilen görev numarası
+    pid_t scheduler_pid;                  // Zamanlayıcıyı çalıştıran instance
+    AdmissionStats admission;             // Baskıya göre kabul kontrolü sayaçları
+    // Görev tablosu en sonda: ls/top/wait snapshot'ları onu kopyalamaz (SNAPSHOT_CORE)
+    ScheduleInfo schedules[MAX_SCHEDULES]; // Zamanlanmış görevler
 } SharedData;
 
+#define SNAPSHOT_CORE offsetof(SharedData, schedules) // Görev tablosu hariç snapshot boyutu
+
 typedef struct
 {
-    long msg_type;    // Mesaj tipi
+    long msg_type;    // Alıcı instance'ın PID'si (her instance yalnızca kendi tipini okur)
     int command;      // Komut (START/TERMINATE)
     pid_t sender_pid; // Gönderen PID
     pid_t target_pid; // Hedef process PID
+    pid_t owner_pid;  // Hedef process'i başlatan instance
+    int error;        // MSG_RUN_REPLY: başlatılamadıysa errno (0: target_pid başlatıldı)
 } Message;
 
+// procx run'ın instance'a gönderdiği başlatma isteği. İlk alanlar Message ile aynıdır,
+// listener ikisini de aynı tamponda alıp command alanına bakar.
+typedef struct
+{
+    long msg_type;            // Alıcı instance'ın PID'si
+    int command;              // MSG_RUN_REQUEST
+    pid_t sender_pid;         // İsteyen procx run (cevap bu PID tipinde gelir)
+    char display[256];        // Tabloda görünen komut
+    int argc;
+    char args[RUN_ARGS_SIZE]; // NUL ile ayrılmış argv (olduğu gibi exec edilir)
+    char cwd[512];            // procx run'ın çalışma dizini (child orada başlar)
+    LaunchOptions opts;
+} RunRequest;
+
+// Event loop'un izlediği fd türleri
+typedef enum
+{
+    WATCH_NOTIFY = 0, // Child'ın hazır bildirimi pipe'ı
+    WATCH_EXEC = 1,   // Child'ın exec durum pipe'ı (EOF: başarılı, errno: başarısız)
+    WATCH_PTY = 2,    // Child'ın PTY master ucu
+    WATCH_ATTACH_LISTEN = 3, // Instance'ın attach soketi
+    WATCH_ATTACH_CLIENT = 4, // procx attach bağlantısı (pid: bağlanılan process)
+    WATCH_PSI = 5,           // /proc/pressure trigger'ı (aux_fd: g_psi indexi, POLLPRI ile izlenir)
+    WATCH_ATTACH_PENDING = 6 // İstek satırı henüz tamamlanmamış attach bağlantısı (buf'ta birikir)
+} WatchType;
+
+// Event loop tarafından poll ile izlenen bir fd
+typedef struct
+{
+    int fd;
+    WatchType type;
+    pid_t pid;     // İlgili child process
+    unsigned int launch_id; // İlgili tablo kaydı
+    int aux_fd;    // WATCH_EXEC: exec başarılı olursa izlenecek bildirim fd'si (-1: yok)
+    char buf[128]; // Satır tamamlanana kadar okunan veri
+    size_t buf_len;
+    struct timespec deadline; // WATCH_NOTIFY: READY=1 için son an (CLOCK_MONOTONIC)
+    int ready_decided;        // WATCH_NOTIFY: READY geldi veya süre doldu, kalan satırlar EOF'a kadar yutulur
+} WatchEntry;
+
+// --pty ile başlatılan bir process'in terminali (process'e özel, shared memory'de değil).
+// Master ucu sahibi olan instance'ta açık kalır; çıktı scrollback halkasında tutulur.
+typedef struct
+{
+    int in_use;
+    pid_t pid;
+    int master_fd;
+    int client_fd;                    // Bağlı procx attach (-1: yok)
+    char scrollback[SCROLLBACK_SIZE]; // Son çıktı (dairesel)
+    unsigned long written;            // Şimdiye kadar yazılan bayt sayısı
+} PtySession;
+
+// procx top görünüm durumu
+typedef struct
+{
+    TopSortKey sort;
+    int reverse;        // Sıralamayı ters çevir
+    char filter[64];    // Komut alt dizesi veya PID/owner PID (boş: hepsi)
+    int editing;        // Filtre düzenleniyor mu ('/')
+    char edit_buf[64];
+    int page;
+    long interval_ms;   // Yenileme aralığı
+    int height, width;  // Çizilen ekran boyutu
+    int is_tty;         // 0 ise kareler düz metin olarak basılır
+} TopView;
+
+// procx top'un ekran tamponları: bir önceki kare ile karşılaştırılıp yalnızca
+// değişen hücreler tek bir write() ile gönderilir
+typedef struct
+{
+    char prev[TOP_MAX_ROWS][TOP_MAX_COLS + 1]; // Ekranda şu an görünen
+    char cur[TOP_MAX_ROWS][TOP_MAX_COLS + 1];  // Yeni kare
+    char out[TOP_MAX_ROWS * (TOP_MAX_COLS + 16)]; // Terminale gidecek baytlar
+    size_t out_len;
+    int full_redraw; // Boyut değişti veya ilk kare
+} TopFrame;
+
+// Spawner kuyruğundaki başlatma isteği
+typedef struct
+{
+    char command[256];
+    ProcessMode mode;
+    LaunchOptions opts;
+    unsigned int schedule_id; // Zamanlayıcıdan geldiyse görev numarası
+    int deferred;             // Kabul kontrolü bekletti mi (ADMIT_DEFERRED/ADMIT_THROTTLED, 0: hayır)
+    time_t deferred_at;       // İlk bekletildiği zaman
+} SpawnRequest;
+
+// Zamanı gelen görev çalıştırması: kilit altında toplanır, kilit bırakıldıktan sonra
+// kuyruğa verilir (zamanlayıcı semaforu tutarken spawner kuyruğunu veya UI'ı beklemez)
+typedef struct
+{
+    int skipped;     // Önceki çalıştırma sürüyordu, başlatılmayacak
+    SpawnRequest req;
+} DueRun;
+
+// Kabul kontrolü kararları
+typedef enum
+{
+    ADMIT_DROPPED = -1,  // Erteleme kuyruğu dolu, istek düşürüldü
+    ADMIT_OK = 0,        // Başlat
+    ADMIT_DEFERRED = 1,  // Baskı geçene kadar bekle (Detached iş)
+    ADMIT_THROTTLED = 2  // Hız sınırı: sıradaki aralıkta tekrar dene
+} AdmissionDecision;
+
+// İzlenen bir PSI kaynağı (/proc/pressure/<name>)
+typedef struct
+{
+    const char *name;
+    int threshold_pct;          // Pencerenin yüzde kaçı "some" stall ise tetiklenir (0: izlenmez)
+    int fd;                     // Trigger fd'si (-1: kurulamadı)
+    struct timespec last_event; // Son tetiklenme (g_spawn_mutex ile korunur)
+} PsiResource;
+
+// Birleştirilebilen bildirim türleri (monitor, listener, spawner, zamanlayıcı ve event loop'tan gelir)
+typedef enum
+{
+    NOTICE_EXITED = 0,     // [MONITOR] process sonlandı
+    NOTICE_IPC_TERMINATED, // [IPC] başka instance'ın process'i sonlandı
+    NOTICE_IPC_CREATED,    // [IPC] başka instance process başlattı
+    NOTICE_IPC_READY,      // [IPC] başka instance'ın process'i hazır
+    NOTICE_READY,          // [READY] kendi process'imiz hazır
+    NOTICE_STARTED,        // [SUCCESS] kendi process'imiz başlatıldı
+    NOTICE_FAILED,         // [HATA] başlatma başarısız oldu veya düşürüldü
+    NOTICE_SCHEDULE,       // [SCHEDULE] görev çalıştırması atlandı
+    NOTICE_PSI,            // [PSI] baskı durumu ve kabul kontrolü kararları
+    NOTICE_NOT_READY,      // [UYARI] kendi process'imiz READY=1 göndermeden Running sayıldı
+    NOTICE_KINDS
+} NoticeKind;
+
+// Pencere boyunca aynı (tür, sahip) için biriken bildirimler
+typedef struct
+{
+    NoticeKind kind;
+    pid_t owner_pid; // Process'i başlatan instance
+    int count;
+    char first[256]; // Grupta tek olay kalırsa aynen basılan mesaj
+} NoticeBucket;
+
+// Zamanlayıcı instance'ının hiyerarşik timer wheel'i (process'e özel, shared memory'de değil).
+// Görevler schedules[] indexleriyle çift yönlü listelerde tutulur.
+typedef struct
+{
+    int head[WHEEL_LEVELS][WHEEL_SLOTS]; // Slot başına liste başı (-1: boş)
+    int next[MAX_SCHEDULES];
+    int prev[MAX_SCHEDULES];
+    time_t expires[MAX_SCHEDULES];
+    unsigned char level[MAX_SCHEDULES];
+    unsigned char slot[MAX_SCHEDULES];
+    unsigned char armed[MAX_SCHEDULES];  // Görev wheel'de mi
+    unsigned int ids[MAX_SCHEDULES];     // Eklendiği andaki görev numarası
+    time_t now;                          // Son işlenen tick
+    unsigned int known_gen;              // Son eşitlenen schedule_gen (arası schedule_log'dan okunur)
+    int active;                          // Bu instance zamanlayıcı mı
+} TimerWheel;
+
 // GLOBAL DEĞİŞKENLER
+char g_domain[MAX_DOMAIN_LEN + 1] = DEFAULT_DOMAIN;     // Bağlanılan domain
+char g_shm_name[64];                                    // Domain'in shared memory adı
+char g_sem_name[64];                                    // Domain'in semafor adı
+char g_private_dir[32];                                 // Kullanıcının özel dizini (PRIVATE_DIR_FMT)
+char g_ipc_key_file[128];                               // Domain'in mesaj kuyruğu anahtar dosyası
 SharedData *g_shared_mem = NULL;                        // Shared memory pointer'ı
 sem_t *g_sem = NULL;                                    // Semafor pointer'ı
 int g_mq_id = -1;                                       // Mesaj kuyruğu ID'si
 volatile sig_atomic_t g_shutdown = 0;                   // Programın çalışıp çalışmadığını tutar
 pthread_mutex_t g_ui_mutex = PTHREAD_MUTEX_INITIALIZER; // UI mutex'i
+WatchEntry g_watches[MAX_WATCHES];                         // Event loop'un izlediği fd'ler
+int g_watch_count = 0;                                     // İzlenen fd sayısı
+pthread_mutex_t g_watch_mutex = PTHREAD_MUTEX_INITIALIZER; // g_watches mutex'i
+int g_wake_pipe[2] = {-1, -1};                             // Event loop'u poll'dan uyandırma pipe'ı
+PtySession g_ptys[MAX_PROCESSES];                          // PTY oturumları (g_watch_mutex ile korunur)
+int g_attach_listen_fd = -1;                               // Attach soketi
+char g_attach_path[108] = "";                              // Attach soketinin yolu (çıkışta silinir)
+SpawnRequest g_spawn_queue[SPAWN_QUEUE_SIZE];              // Başlatma istekleri (dairesel)
+int g_spawn_queue_head = 0;                                // Sıradaki isteğin indexi
+int g_spawn_queue_len = 0;                                 // Bekleyen istek sayısı
+pthread_mutex_t g_spawn_mutex = PTHREAD_MUTEX_INITIALIZER; // Kuyruk mutex'i
+pthread_cond_t g_spawn_cond = PTHREAD_COND_INITIALIZER;    // Kuyruğa istek geldi sinyali
+TimerWheel g_wheel;                                        // Zamanlayıcı (yalnızca monitor thread'i kullanır)
+PsiResource g_psi[PSI_RESOURCES] = {                       // PROCX_PSI ile değiştirilebilir
+    {.name = "cpu", .threshold_pct = 80, .fd = -1},
+    {.name = "memory", .threshold_pct = 10, .fd = -1},
+    {.name = "io", .threshold_pct = 40, .fd = -1},
+};
+int g_psi_detached_first = 1;                              // Baskıda Detached işleri tamamen ertele
+long g_psi_throttle_ms = 1000;                             // Baskıda başlatmalar arası en kısa süre
+SpawnRequest g_deferred[SPAWN_QUEUE_SIZE];                 // Bekletilen istekler (g_spawn_mutex ile korunur)
+int g_deferred_len = 0;                                    // Bekletilen istek sayısı
+struct
+{
+    unsigned int launch_id;
+    pid_t reply_pid;
+} g_run_replies[SPAWN_QUEUE_SIZE];                         // Sonucu bekleyen procx run istekleri (g_spawn_mutex)
+int g_run_reply_count = 0;
+pid_t g_reap_pids[SPAWN_QUEUE_SIZE];                       // Exec'i başarısız, henüz toplanmamış child'lar (g_spawn_mutex)
+int g_reap_count = 0;
+struct timespec g_last_admit;                              // Son kabul edilen başlatma (g_spawn_mutex)
+unsigned int g_pressure_mask = 0;                          // Bildirilen son baskı durumu (g_spawn_mutex)
+TopSortKey g_top_sort = TOP_SORT_RUNTIME;                  // procx top karşılaştırıcısının anahtarı
+const char *const g_top_sort_names[] = {"runtime", "owner", "mode", "pid"};
+NoticeBucket g_notices[NOTICE_BUCKETS];                    // Bekleyen bildirim grupları (g_notice_mutex)
+int g_notice_count = 0;                                    // Dolu grup sayısı
+int g_notice_overflow[NOTICE_KINDS];                       // Gruplara sığmayan olaylar (tür başına)
+int g_notice_overflow_total = 0;                           // Gruplara sığmayan toplam olay
+struct timespec g_notice_deadline;                         // Bekleyenlerin basılacağı an (CLOCK_MONOTONIC)
+double g_notice_tokens = 0;                                // Kalan satır hakkı (token bucket)
+struct timespec g_notice_refill;                           // Son hak yenileme anı
+pthread_mutex_t g_notice_mutex = PTHREAD_MUTEX_INITIALIZER;
+long g_notice_window_ms = 250;                             // Olayların birleştirildiği pencere (0: hemen bas)
+int g_notice_rate = 4;                                     // Saniyede en fazla satır (0: sınırsız)
+int g_notice_burst = 8;                                    // Tek seferde basılabilecek en fazla satır
+
+// Hazır öncelik profilleri ("--profile NAME")
+// Açıkça verilen seçenekler profilin değerlerini ezer.
+const LaunchOptions g_profiles[] = {
+    {.profile = "default"},
+    {.profile = "service", .ioprio_class = IOPRIO_CLASS_BE, .ioprio_level = 0, .nofile_limit = 4096},
+    {.profile = "batch", .nice = 10, .ioprio_class = IOPRIO_CLASS_BE, .ioprio_level = 7, .oom_score_adj = 500},
+    {.profile = "idle", .nice = 19, .ioprio_class = IOPRIO_CLASS_IDLE, .oom_score_adj = 1000},
+};
 
 // Fonksiyon prototipleri
-void init_ipc_resources();
+int set_domain(const char *name);
+int open_private_dir(int create);
+int init_ipc_resources(int register_instance);
+const SharedData *attach_shared_readonly();
 void disconnect_ipc_resources();
 void destroy_ipc_resources();
+void lock_shared();
+void unlock_shared();
+int snapshot_shared(const SharedData *src, SharedData *dst, int with_schedules);
 void clean_exit();
 void *monitor_processes(void *arg);
 void *ipc_listener(void *arg);
+void *event_loop(void *arg);
+int add_watch(int fd, WatchType type, pid_t pid, unsigned int launch_id, int aux_fd);
+int add_notify_watch(int fd, pid_t pid, unsigned int launch_id, int timeout_sec);
+int open_pty_session(pid_t pid, int master_fd);
+int open_attach_socket();
+void accept_attach_client();
+void attach_client(int client, const char *header);
+int read_notify(WatchEntry *watch);
+long mark_process_ready(pid_t pid, int ready);
+void give_up_ready(pid_t pid, const char *reason);
+int notify_timeout_ms();
+void expire_notify_watches();
 void send_ipc_message(Message *msg);
 int parse_command(char *command, char *argv[]);
-void create_new_process(char *command, ProcessMode mode);
+int parse_launch_options(int argc, char *argv[], LaunchOptions *opts);
+int apply_launch_options(const LaunchOptions *opts);
+unsigned int reserve_slot(const char *command, ProcessMode mode, const LaunchOptions *opts,
+                          unsigned int schedule_id);
+ProcessInfo *find_slot(unsigned int launch_id);
+void set_slot_pid(unsigned int launch_id, pid_t pid, const struct timespec *start_mono);
+void release_slot(unsigned int launch_id);
+int commit_slot(unsigned int launch_id, pid_t pid, int await_ready);
+pid_t fork_child(char *command, char *const exec_argv[], const char *cwd, ProcessMode mode, const LaunchOptions *opts,
+                 int *exec_fd, int *notify_fd, int *pty_fd, struct timespec *start_mono);
+int read_exec_status(int fd, int *child_err);
+void launch_child(const char *command, char *const exec_argv[], const char *cwd, ProcessMode mode,
+                  const LaunchOptions *opts, unsigned int schedule_id, pid_t reply_pid);
+void handle_run_request(const RunRequest *req);
+int submit_spawn(const char *command, ProcessMode mode, const LaunchOptions *opts, unsigned int schedule_id);
+void finish_spawn(pid_t pid, unsigned int launch_id, int notify_fd, int result, int child_err);
+void reap_failed_children();
+void *spawner_thread(void *arg);
+void init_psi();
+void psi_event(int resource);
+void resume_deferred();
+int deferred_timeout_ms();
+void create_new_process(char *command, ProcessMode mode, const LaunchOptions *opts);
+int parse_cron(const char *expr, CronSpec *spec);
+time_t next_cron_time(const CronSpec *spec, time_t after);
+void scheduler_tick();
+void note_schedule_change(int idx);
+unsigned int schedule_add(int argc, char *argv[]);
+int schedule_remove(unsigned int id);
+void print_schedules(SharedData *data);
 void terminate_process(pid_t target_pid);
+void record_exit(ProcessInfo *proc, const int *status, const struct rusage *usage);
 void print_program_output();
 void print_running_processes(SharedData *data);
-void repaint_ui(const char *message);
+void print_exit_history(SharedData *data);
+void init_notices();
+void post_notice(NoticeKind kind, pid_t owner_pid, const char *message);
+int notice_timeout_ms();
+void flush_notices();
+void print_json_string(const char *str);
+int run_cli(int argc, char const *argv[]);
+
+// Domain'i seçer ve IPC kaynak adlarını oluşturur. Ad yalnızca harf, rakam, '-' ve '_'
+// içerebilir (kaynak adlarına ve dosya yoluna girdiği için). Geçersizse -1 döner.
+int set_domain(const char *name)
+{
+    size_t len = strlen(name);
+    if (len == 0 || len > MAX_DOMAIN_LEN)
+        return -1;
+    for (size_t i = 0; i < len; i++)
+    {
+        char c = name[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_'))
+            return -1;
+    }
+
+    // Kullanıcılar aynı domain adını kullansa da kaynakları karışmaz
+    unsigned int uid = (unsigned int)getuid();
+    strcpy(g_domain, name);
+    snprintf(g_shm_name, sizeof(g_shm_name), SHM_NAME_FMT, uid, name);
+    snprintf(g_sem_name, sizeof(g_sem_name), SEM_NAME_FMT, uid, name);
+    snprintf(g_private_dir, sizeof(g_private_dir), PRIVATE_DIR_FMT, uid);
+    snprintf(g_ipc_key_file, sizeof(g_ipc_key_file), "%s/" IPC_KEY_PREFIX "%s", g_private_dir, name);
+    return 0;
+}
+
+// Kaynak bu kullanıcıya ait ve başkalarına kapalı mı? Değilse hatayı basıp -1 döner.
+// Adlar tahmin edilebilir olduğu için başka bir kullanıcı kaynağı önceden oluşturup
+// instance'ı ona bağlayabilir; bu yüzden açılan her kaynak kullanılmadan önce doğrulanır.
+static int check_owner(uid_t uid, mode_t mode, const char *what)
+{
+    if (uid == geteuid() && (mode & 077) == 0)
+        return 0;
+    fprintf(stderr, "[HATA] %s bu kullanıcıya ait değil veya başkalarına açık (uid %u, izin %03o); kullanılmıyor.\n",
+            what, (unsigned int)uid, (unsigned int)(mode & 0777));
+    return -1;
+}
+
+// Kullanıcının özel dizinini doğrular; create 1 ise yoksa 0700 ile oluşturur.
+// Anahtar dosyası ve attach soketi bu dizinde durur, böylece /tmp'deki tahmin edilebilir
+// yollara başkası önceden dosya veya soket koyamaz. Dizin yoksa veya güvenli değilse -1 döner.
+int open_private_dir(int create)
+{
+    if (create && mkdir(g_private_dir, 0700) == -1 && errno != EEXIST)
+    {
+        perror("Özel dizin oluşturulamadı");
+        return -1;
+    }
+
+    struct stat st;
+    if (lstat(g_private_dir, &st) == -1)
+    {
+        if (create)
+            perror("Özel dizin okunamadı");
+        return -1;
+    }
+    if (!S_ISDIR(st.st_mode))
+    {
+        fprintf(stderr, "[HATA] %s bir dizin değil; kullanılmıyor.\n", g_private_dir);
+        return -1;
+    }
+    return check_owner(st.st_uid, st.st_mode, g_private_dir);
+}
+
+// Açılmış shared memory fd'sini doğrular
+static int check_shm_fd(int shm_fd)
+{
+    struct stat st;
+    if (fstat(shm_fd, &st) == -1)
+        return -1;
+    return check_owner(st.st_uid, st.st_mode, g_shm_name);
+}
+
+// Açılmış semaforu doğrular. Linux'ta adlı semaforlar /dev/shm/sem.<ad> dosyasıdır;
+// diğer platformlarda dosya karşılığı olmadığından yalnızca açılış izinlerine güvenilir.
+static int check_sem()
+{
+#ifdef __linux__
+    char path[96];
+    struct stat st;
+    snprintf(path, sizeof(path), "/dev/shm/sem.%s", g_sem_name + 1);
+    if (lstat(path, &st) == -1)
+        return -1;
+    return check_owner(st.st_uid, st.st_mode, path);
+#else
+    return 0;
+#endif
+}
+
+// Mesaj kuyruğunun sahibini ve izinlerini IPC_STAT ile doğrular
+static int check_queue(int mq_id)
+{
+    struct msqid_ds ds;
+    if (msgctl(mq_id, IPC_STAT, &ds) == -1)
+        return -1;
+    return check_owner(ds.msg_perm.uid, ds.msg_perm.mode, "Mesaj kuyruğu");
+}
+
+// Anahtar dosyasını açıp doğrular ve ftok anahtarını üretir (create 1 ise yoksa oluşturur).
+// O_NOFOLLOW symlink'i reddeder; fstat da dosyanın bu kullanıcıya ait olduğunu garanti eder.
+static key_t open_ipc_key(int create)
+{
+    int fd = open(g_ipc_key_file, (create ? O_CREAT | O_RDWR : O_RDONLY) | O_NOFOLLOW | O_CLOEXEC, IPC_MODE);
+    if (fd == -1)
+    {
+        if (create)
+            perror("IPC Key dosyası oluşturulamadı");
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || check_owner(st.st_uid, st.st_mode, g_ipc_key_file) == -1)
+    {
+        close(fd);
+        return -1;
+    }
+    close(fd);
+
+    key_t key = ftok(g_ipc_key_file, 65);
+    if (key == -1 && create)
+        perror("ftok hatası");
+    return key;
+}
 
 // IPC kaynaklarını oluşturma fonksiyonu (mesaj kuyruğu, paylaşılan bellek, semafor)
-void init_ipc_resources()
+// register_instance 0 ise (kısa süreli CLI bağlantısı) yalnızca var olan kaynaklara
+// bağlanılır ve instance sayacı artırılmaz, böylece bu bağlantı yayın mesajlarının alıcısı
+// olarak sayılmaz. Çalışan instance yoksa hiçbir şey oluşturmadan -1 döner.
+int init_ipc_resources(int register_instance)
 {
     int shm_fd;
     int is_first_instance = 0;
 
+    if (!register_instance)
+    {
+        // Kaynak bırakmamak için O_CREAT yok: instance yoksa segment de yoktur
+        if (open_private_dir(0) == -1)
+            return -1;
+        shm_fd = shm_open(g_shm_name, O_RDWR, 0);
+        struct stat st;
+        if (shm_fd == -1 || check_shm_fd(shm_fd) == -1 ||
+            fstat(shm_fd, &st) == -1 || st.st_size < (off_t)sizeof(SharedData))
+        {
+            if (shm_fd != -1)
+                close(shm_fd);
+            return -1;
+        }
+        g_shared_mem = (SharedData *)mmap(NULL, sizeof(SharedData),
+                                          PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+        close(shm_fd);
+        if (g_shared_mem == MAP_FAILED)
+        {
+            g_shared_mem = NULL;
+            return -1;
+        }
+
+        key_t key = open_ipc_key(0);
+        g_sem = sem_open(g_sem_name, 0);
+        if (g_sem == SEM_FAILED || check_sem() == -1 || key == -1 ||
+            (g_mq_id = msgget(key, 0)) == -1 || check_queue(g_mq_id) == -1)
+        {
+            if (g_sem == SEM_FAILED)
+                g_sem = NULL;
+            disconnect_ipc_resources();
+            return -1;
+        }
+        return 0;
+    }
+
+    // Anahtar dosyası ve attach soketi bu dizinde oluşturulacak
+    if (open_private_dir(1) == -1)
+        exit(1);
+
     /*
     Shared Memory oluşturma/bağlanma
     O_CREAT : Eğer yoksa oluştur
     O_EXCL  : Eğer zaten varsa hata ver
     O_RDWR  : Okuma/Yazma izni
-    0666    : İzinler (okuma/yazma herkes için)
+    0600    : İzinler (yalnızca sahibi okuyup yazabilir)
     */
-    shm_fd = shm_open(SHM_NAME, O_CREAT | O_EXCL | O_RDWR, 0666);
+    shm_fd = shm_open(g_shm_name, O_CREAT | O_EXCL | O_RDWR, IPC_MODE);
 
     // Shared memory oluştuysa >= 0 döner
     if (shm_fd >= 0)
@@ -108,7 +726,7 @@ void init_ipc_resources()
         if (ftruncate(shm_fd, sizeof(SharedData)) == -1)
         {
             perror("ftruncate hatası");
-            shm_unlink(SHM_NAME);
+            shm_unlink(g_shm_name);
             exit(1);
         }
     }
@@ -117,13 +735,19 @@ void init_ipc_resources()
         if (errno == EEXIST)
         {
             // Zaten var, normal aç
-            shm_fd = shm_open(SHM_NAME, O_RDWR, 0666);
+            shm_fd = shm_open(g_shm_name, O_RDWR, IPC_MODE);
             // Hata kontrolü
             if (shm_fd == -1)
             {
                 perror("Shared memory açma hatası");
                 exit(1);
             }
+            // Başkasının önceden oluşturduğu segmente bağlanma
+            if (check_shm_fd(shm_fd) == -1)
+            {
+                close(shm_fd);
+                exit(1);
+            }
         }
         else
         {
@@ -144,70 +768,169 @@ void init_ipc_resources()
         exit(1);
     }
 
-    // Eğer ilk instance ise belleği sıfırla
+    // Eğer ilk instance ise belleği sıfırla. Görev tablosuna dokunulmaz: ftruncate yeni
+    // segmenti zaten sıfırla doldurur ve tablonun sayfaları ancak görev eklendikçe ayrılır.
     if (is_first_instance)
     {
-        memset(g_shared_mem, 0, sizeof(SharedData));
+        memset(g_shared_mem, 0, SNAPSHOT_CORE);
         g_shared_mem->process_count = 0;
     }
 
     // Semafor oluşturma/bağlanma
-    g_sem = sem_open(SEM_NAME, O_CREAT, 0666, 1);
+    g_sem = sem_open(g_sem_name, O_CREAT, IPC_MODE, 1);
     if (g_sem == SEM_FAILED)
     {
         perror("Semafor açma hatası");
         exit(1);
     }
-
-    // Mesaj kuyruğu için IPC key dosyasını oluştur
-    int fd = open(IPC_KEY_FILE, O_CREAT | O_RDWR, 0666);
-    if (fd == -1)
-    {
-        perror("IPC Key dosyası oluşturulamadı");
+    if (check_sem() == -1)
         exit(1);
-    }
-    close(fd);
 
-    // Key oluştur
-    key_t key = ftok(IPC_KEY_FILE, 65);
+    // Mesaj kuyruğu için IPC key dosyasını oluştur ve key üret
+    key_t key = open_ipc_key(1);
     if (key == -1)
-    {
-        perror("ftok hatası");
         exit(1);
-    }
 
     // Mesaj kuyruğu oluşturma/baglanma
-    if ((g_mq_id = msgget(key, 0666 | IPC_CREAT)) == -1)
+    if ((g_mq_id = msgget(key, IPC_MODE | IPC_CREAT)) == -1)
     {
         perror("Message queue oluşturma hatası");
         exit(1);
     }
+    if (check_queue(g_mq_id) == -1)
+        exit(1);
+
+    if (register_instance)
+    {
+        lock_shared();
+        // Çökmüş instance'ları listeden düşür, kendimizi alıcı olarak ekle
+        int kept = 0;
+        for (int i = 0; i < g_shared_mem->instance_count && i < MAX_INSTANCES; i++)
+        {
+            pid_t pid = g_shared_mem->instance_pids[i];
+            if (!(kill(pid, 0) == -1 && errno == ESRCH))
+                g_shared_mem->instance_pids[kept++] = pid;
+        }
+        g_shared_mem->instance_count = kept;
+        int full = (kept >= MAX_INSTANCES);
+        if (!full)
+            g_shared_mem->instance_pids[g_shared_mem->instance_count++] = getpid();
+        unlock_shared();
+
+        if (full)
+        {
+            fprintf(stderr, "[HATA] '%s' domain'inde en fazla %d instance çalışabilir.\n", g_domain, MAX_INSTANCES);
+            exit(1);
+        }
+    }
+    return 0;
+}
+
+// Shared memory'yi salt-okunur eşler (ls, wait gibi sorgular için).
+// Semafor, mesaj kuyruğu ve instance sayacına dokunmaz; thread başlatmaz.
+// Segment yoksa (hiç instance çalışmamışsa) NULL döner.
+const SharedData *attach_shared_readonly()
+{
+    int shm_fd = shm_open(g_shm_name, O_RDONLY, 0);
+    if (shm_fd == -1)
+    {
+        return NULL;
+    }
+
+    // Segment henüz ftruncate edilmemişse (ilk instance açılıyorsa) eşleme yapma
+    struct stat st;
+    if (check_shm_fd(shm_fd) == -1 || fstat(shm_fd, &st) == -1 || st.st_size < (off_t)sizeof(SharedData))
+    {
+        close(shm_fd);
+        return NULL;
+    }
+
+    SharedData *data = (SharedData *)mmap(NULL, sizeof(SharedData), PROT_READ, MAP_SHARED, shm_fd, 0);
+    close(shm_fd);
+    if (data == MAP_FAILED)
+    {
+        return NULL;
+    }
+    g_shared_mem = data;
+    return data;
+}
 
+// Shared memory'ye yazma kilidi
+// Semaforu aldıktan sonra seqlock sayacını tek sayıya çeker. Böylece semafor
+// almayan okuyucular (snapshot_shared) yarım kalmış bir yazmayı fark edebilir.
+void lock_shared()
+{
     sem_wait(g_sem);
-    // Instance sayısını artır
-    g_shared_mem->instance_count++;
+    __atomic_add_fetch(&g_shared_mem->seq, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+// Yazma kilidini bırakır, sayaç tekrar çift sayıya döner
+void unlock_shared()
+{
+    __atomic_add_fetch(&g_shared_mem->seq, 1, __ATOMIC_RELEASE);
     sem_post(g_sem);
 }
 
+// Semafor almadan shared memory'nin tutarlı bir kopyasını çıkarır.
+// with_schedules 0 ise görev tablosu kopyalanmaz (dst->schedules dokunulmadan kalır);
+// tablo segmentin büyük kısmıdır ve yalnızca schedule ls ile domains ona bakar. Kopyalanırsa
+// yalnızca ilk schedule_high kaydı alınır, okuyucular da tabloyu o sınıra kadar dolaşır.
+// Kopyalama sırasında bir yazma olduysa tekrar dener. Başarılıysa 0 döner.
+int snapshot_shared(const SharedData *src, SharedData *dst, int with_schedules)
+{
+    for (int attempt = 0; attempt < 1000; attempt++)
+    {
+        unsigned int before = __atomic_load_n(&src->seq, __ATOMIC_ACQUIRE);
+        if (before & 1)
+        {
+            // Yazma devam ediyor, yazarın işini bitirmesini bekle
+            sched_yield();
+            continue;
+        }
+
+        size_t len = SNAPSHOT_CORE;
+        if (with_schedules)
+        {
+            int high = __atomic_load_n(&src->schedule_high, __ATOMIC_RELAXED);
+            if (high < 0 || high > MAX_SCHEDULES)
+                high = MAX_SCHEDULES; // Yarım okunmuş değer: seq değişeceği için tekrar denenir
+            len += (size_t)high * sizeof(ScheduleInfo);
+        }
+
+        memcpy(dst, src, len);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&src->seq, __ATOMIC_RELAXED) == before)
+        {
+            return 0;
+        }
+    }
+    return -1;
+}
+
 // IPC kaynaklarından bağlantıyı kesme fonksiyonu
 void disconnect_ipc_resources()
 {
     if (g_shared_mem != NULL)
     {
         munmap(g_shared_mem, sizeof(SharedData));
+        g_shared_mem = NULL;
     }
     if (g_sem != NULL)
     {
         sem_close(g_sem);
+        g_sem = NULL;
     }
 }
 
 // Son instance için IPC kaynaklarını yok etme fonksiyonu
 void destroy_ipc_resources()
 {
-    shm_unlink(SHM_NAME);
-    sem_unlink(SEM_NAME);
+    shm_unlink(g_shm_name);
+    sem_unlink(g_sem_name);
     msgctl(g_mq_id, IPC_RMID, NULL);
+    unlink(g_ipc_key_file); // Domain listesinden de düşsün
 }
 
 // Instance için çıkış fonksiyonu
@@ -216,43 +939,75 @@ void clean_exit()
     // Kendi başlattığımız Attached Process'leri öldür ve bildir
     if (g_sem != NULL && g_shared_mem != NULL)
     {
-        sem_wait(g_sem);
+        // Bekletilen başlatmalar instance ile birlikte düşer
+        pthread_mutex_lock(&g_spawn_mutex);
+        int dropped = g_deferred_len;
+        g_deferred_len = 0;
+        pthread_mutex_unlock(&g_spawn_mutex);
+
+        Message exits[MAX_PROCESSES]; // Öldürülen process'lerin mesajları
+        int exit_count = 0;
+
+        lock_shared();
+        g_shared_mem->admission.waiting -= dropped;
 
         for (int i = 0; i < g_shared_mem->process_count; i++)
         {
             ProcessInfo *proc = &g_shared_mem->processes[i];
 
             // Sadece attached ve kendi başlattıklarımızı öldür
-            if (proc->is_active && proc->owner_pid == getpid() && proc->mode == MODE_ATACHED)
+            if (proc->is_active && proc->owner_pid == getpid() && proc->mode == MODE_ATACHED && proc->pid > 0)
             {
                 // Processi kill et
                 if (kill(proc->pid, SIGTERM) == 0)
                 {
+                    // Geçmişe ekle (çıkış durumu toplanamayacak, instance kapanıyor)
+                    record_exit(proc, NULL, NULL);
+
                     // Shared Memory'de durumu güncelle
                     proc->is_active = 0;
                     proc->status = STATUS_TERMINATED;
 
-                    // Diğer Terminallere IPC Mesajı Gönder
-                    Message msg;
-                    msg.msg_type = 1;
-                    msg.command = STATUS_TERMINATED;
-                    msg.sender_pid = getpid();
-                    msg.target_pid = proc->pid;
-
-                    // Mesaj gönderme (msgsnd)
-                    if (g_mq_id != -1)
-                    {
-                        send_ipc_message(&msg);
-                    }
+                    // Diğer terminallere IPC mesajı kilit bırakıldıktan sonra gider
+                    Message *msg = &exits[exit_count++];
+                    msg->command = STATUS_TERMINATED;
+                    msg->sender_pid = getpid();
+                    msg->target_pid = proc->pid;
+                    msg->owner_pid = getpid();
                 }
             }
         }
 
-        // Sayacı azalt ve sonuncu instance mıyım kontrol et
-        g_shared_mem->instance_count--;
+        // Attach soketini sil (PTY'ler instance ile birlikte kapanır)
+        if (g_attach_path[0] != '\0')
+        {
+            unlink(g_attach_path);
+        }
+
+        // Zamanlayıcı bizdeyse bırak, başka bir instance devralsın
+        if (g_shared_mem->scheduler_pid == getpid())
+        {
+            g_shared_mem->scheduler_pid = 0;
+        }
+
+        // Alıcı listesinden çık ve sonuncu instance mıyım kontrol et
+        for (int i = 0; i < g_shared_mem->instance_count; i++)
+        {
+            if (g_shared_mem->instance_pids[i] == getpid())
+            {
+                g_shared_mem->instance_pids[i] = g_shared_mem->instance_pids[g_shared_mem->instance_count - 1];
+                g_shared_mem->instance_count--;
+                break;
+            }
+        }
         int remaining_instances = g_shared_mem->instance_count;
 
-        sem_post(g_sem);
+        unlock_shared();
+
+        // Diğer instance'lar semaforu beklemesin diye mesajlar kilit dışında gider
+        // (msgsnd, kuyruk doluysa beklemez)
+        for (int i = 0; i < exit_count && g_mq_id != -1; i++)
+            send_ipc_message(&exits[i]);
 
         // IPC kaynaklarını temizleme işlemleri
         if (remaining_instances <= 0)
@@ -273,19 +1028,32 @@ void *monitor_processes(void *arg)
 {
     (void)arg; // Makefile unused parameter warning go away
     char buffer[256];
+    Message exits[MAX_PROCESSES]; // Bu turda sonlanan process'lerin mesajları
+    unsigned long tick = 0;
     while (1)
     {
-        sleep(2); // 2 saniyede bir kontrol et
+        sleep(1); // Zamanlayıcı saniyede bir ilerler
 
         if (g_shared_mem == NULL || g_sem == NULL)
             continue;
 
-        sem_wait(g_sem);
+        scheduler_tick();
+        resume_deferred();
+        reap_failed_children();
+
+        if (++tick % 2 != 0)
+            continue; // Process'leri 2 saniyede bir kontrol et
+
+        int exit_count = 0;
+        lock_shared();
 
         for (int i = 0; i < g_shared_mem->process_count; i++)
         {
             ProcessInfo *proc = &g_shared_mem->processes[i];
             int should_clean = 0; // Silinmeli mi bayrağı
+            int status;
+            int have_status = 0; // wait4 çıkış durumunu topladı mı
+            struct rusage usage;
 
             // Process inaktifse direkt sil (belki yanlışlıkla kalmıştır vs)
             if (!proc->is_active)
@@ -296,6 +1064,13 @@ void *monitor_processes(void *arg)
                 continue;
             }
 
+            // Exec sonucu henüz belli olmayan (yer ayrılmış) kayıtlara dokunma.
+            // pid 0 iken waitpid/kill tüm process grubunu hedef alırdı.
+            if (proc->status == STATUS_CREATED || proc->pid <= 0)
+            {
+                continue;
+            }
+
             // Eğer process başka bir instance'a aitse waitpid çağırma.
             // Sadece detached ve zaten inactive olanları temizle.
             if (proc->owner_pid != getpid())
@@ -317,13 +1092,13 @@ void *monitor_processes(void *arg)
             {
                 if (proc->is_active) // Process aktifse
                 {
-                    int status;
-                    // Non-blocking waitpid ile kontrol et
+                    // Non-blocking wait4 ile kontrol et (waitpid + kaynak kullanımı)
                     // Eğer process sonlandıysa should_clean = 1 yap
-                    pid_t result = waitpid(proc->pid, &status, WNOHANG);
+                    pid_t result = wait4(proc->pid, &status, WNOHANG, &usage);
                     if (result > 0)
                     {
                         should_clean = 1;
+                        have_status = 1;
                     }
                     else if (result == 0)
                     {
@@ -339,7 +1114,7 @@ void *monitor_processes(void *arg)
                         }
                         else
                         {
-                            perror("waitpid hatası");
+                            perror("wait4 hatası");
                             continue;
                         }
                     }
@@ -348,17 +1123,32 @@ void *monitor_processes(void *arg)
 
             if (should_clean)
             {
+                // Çıkış bilgisini geçmiş halkasına yaz
+                record_exit(proc, have_status ? &status : NULL, have_status ? &usage : NULL);
+
                 // Process sonlandı bilgisini ver
-                snprintf(buffer, sizeof(buffer), "[MONITOR] Process sonlandı: PID %d", proc->pid);
-                repaint_ui(buffer);
+                if (have_status && WIFSIGNALED(status))
+                {
+                    snprintf(buffer, sizeof(buffer), "[MONITOR] Process sonlandı: PID %d (Sinyal %d)",
+                             proc->pid, WTERMSIG(status));
+                }
+                else if (have_status)
+                {
+                    snprintf(buffer, sizeof(buffer), "[MONITOR] Process sonlandı: PID %d (Çıkış kodu %d)",
+                             proc->pid, WEXITSTATUS(status));
+                }
+                else
+                {
+                    snprintf(buffer, sizeof(buffer), "[MONITOR] Process sonlandı: PID %d", proc->pid);
+                }
+                post_notice(NOTICE_EXITED, proc->owner_pid, buffer);
 
-                // IPC Mesajı Gönder
-                Message msg;
-                msg.msg_type = 1;
-                msg.command = STATUS_TERMINATED;
-                msg.sender_pid = getpid();
-                msg.target_pid = proc->pid;
-                send_ipc_message(&msg);
+                // IPC mesajı kilit bırakıldıktan sonra gönderilir
+                Message *msg = &exits[exit_count++];
+                msg->command = STATUS_TERMINATED;
+                msg->sender_pid = getpid();
+                msg->target_pid = proc->pid;
+                msg->owner_pid = proc->owner_pid;
 
                 // Shared Memory'den sil (Kaydırma Yöntemi)
                 g_shared_mem->processes[i] = g_shared_mem->processes[g_shared_mem->process_count - 1];
@@ -366,50 +1156,151 @@ void *monitor_processes(void *arg)
                 i--; // Kaydırma sonrası aynı indexi tekrar kontrol et
             }
         }
-        sem_post(g_sem);
+        unlock_shared();
+
+        // Diğer instance'lar semaforu beklemesin diye mesajlar kilit dışında gider
+        for (int i = 0; i < exit_count; i++)
+            send_ipc_message(&exits[i]);
     }
     return NULL;
 }
 
+// Sonlanan process'i geçmiş halkasına yazar. Çağıran shared memory kilidini tutmalıdır.
+// status NULL ise çıkış durumu bilinmiyor demektir (başka instance'ın process'i
+// veya sahibi kapanırken öldürülen process).
+void record_exit(ProcessInfo *proc, const int *status, const struct rusage *usage)
+{
+    ExitRecord *rec = &g_shared_mem->history[g_shared_mem->history_total % MAX_HISTORY];
+
+    memset(rec, 0, sizeof(*rec));
+    rec->pid = proc->pid;
+    rec->owner_pid = proc->owner_pid;
+    memcpy(rec->command, proc->command, sizeof(rec->command));
+    rec->mode = proc->mode;
+    rec->start_time = proc->start_time;
+    rec->end_time = time(NULL);
+    rec->exit_code = -1;
+
+    if (status != NULL)
+    {
+        rec->status_known = 1;
+        if (WIFEXITED(*status))
+            rec->exit_code = WEXITSTATUS(*status);
+        else if (WIFSIGNALED(*status))
+            rec->term_signal = WTERMSIG(*status);
+    }
+
+    if (usage != NULL)
+    {
+        rec->user_time_ms = usage->ru_utime.tv_sec * 1000L + usage->ru_utime.tv_usec / 1000;
+        rec->sys_time_ms = usage->ru_stime.tv_sec * 1000L + usage->ru_stime.tv_usec / 1000;
+#ifdef __APPLE__
+        rec->max_rss_kb = usage->ru_maxrss / 1024; // macOS byte cinsinden verir
+#else
+        rec->max_rss_kb = usage->ru_maxrss;
+#endif
+    }
+
+    g_shared_mem->history_total++;
+}
+
 // IPC Mesajı Gönderme Fonksiyonu
+// Diğer her instance'a kendi PID'si tipinde bir kopya gönderir; böylece her listener
+// yalnızca kendi kopyasını alır ve kuyruğu başkasının payını çalmadan boşaltabilir.
+// Kuyruk doluysa beklenmez (bildirim düşer), bu yüzden kilit tutarken de çağrılabilir.
 void send_ipc_message(Message *msg)
 {
-    // Sistemdeki toplam instance (terminal) sayısını al
     int total_instances = g_shared_mem->instance_count;
-    // Kendim dahil tüm instance'lara mesaj gönder (her instance mesaj kuyruğunu okuyacak)
-    // Kendi mesajlarımızı zaten yutuyoruz listener thread'te
+    if (total_instances > MAX_INSTANCES)
+        total_instances = MAX_INSTANCES;
     for (int i = 0; i < total_instances; i++)
     {
-        if (msgsnd(g_mq_id, msg, sizeof(Message) - sizeof(long), 0) == -1)
+        pid_t pid = g_shared_mem->instance_pids[i];
+        if (pid <= 0 || pid == getpid())
+            continue;
+        if (kill(pid, 0) == -1 && errno == ESRCH)
+            continue; // Çökmüş instance: kopyası kuyrukta birikmesin
+
+        msg->msg_type = pid;
+        if (msgsnd(g_mq_id, msg, sizeof(Message) - sizeof(long), IPC_NOWAIT) == -1 && errno != EAGAIN)
         {
             perror("Mesaj gönderme hatası");
         }
     }
 }
 
+// Listener'ın mükerrer mesaj geçmişi (yalnızca listener thread'i kullanır).
+// Son 20 mesajın PID, komut ve zamanını tutar.
+static struct
+{
+    pid_t pid;
+    int command;
+    time_t timestamp;
+} g_ipc_history[20];
+static int g_ipc_history_idx = 0;
+
+// Aynı PID ve komut için son 2 saniye içinde mesaj geldiyse 1 döner, gelmediyse
+// mesajı geçmişe ekler ve 0 döner (CREATED ve READY aynı PID için art arda gelebilir).
+static int is_duplicate_message(const Message *msg)
+{
+    time_t now = time(NULL);
+    for (int i = 0; i < 20; i++)
+    {
+        if (g_ipc_history[i].pid == msg->target_pid && g_ipc_history[i].command == msg->command &&
+            (now - g_ipc_history[i].timestamp) <= 2)
+        {
+            return 1;
+        }
+    }
+
+    // Yeni mesajı geçmişe ekle
+    g_ipc_history[g_ipc_history_idx].pid = msg->target_pid;
+    g_ipc_history[g_ipc_history_idx].command = msg->command;
+    g_ipc_history[g_ipc_history_idx].timestamp = now;
+    g_ipc_history_idx = (g_ipc_history_idx + 1) % 20; // Dairesel döngü
+    return 0;
+}
+
+// Başka instance'tan gelen mesajı ekrana basar
+static void show_ipc_message(const Message *msg)
+{
+    char buffer[256];
+
+    if (msg->command == STATUS_TERMINATED)
+    {
+        snprintf(buffer, sizeof(buffer), "[IPC] Process sonlandırıldı: PID %d", msg->target_pid);
+        post_notice(NOTICE_IPC_TERMINATED, msg->owner_pid, buffer);
+    }
+    else if (msg->command == STATUS_CREATED)
+    {
+        snprintf(buffer, sizeof(buffer), "[IPC] Yeni process başlatıldı: PID %d", msg->target_pid);
+        post_notice(NOTICE_IPC_CREATED, msg->owner_pid, buffer);
+    }
+    else if (msg->command == STATUS_RUNNING)
+    {
+        snprintf(buffer, sizeof(buffer), "[IPC] Process hazır (READY): PID %d", msg->target_pid);
+        post_notice(NOTICE_IPC_READY, msg->owner_pid, buffer);
+    }
+}
+
 // IPC Listener fonksiyonu
 void *ipc_listener(void *arg)
 {
     (void)arg; // Makefile unused parameter warning go away
-    Message msg;
-    char buffer[256];
-
-    // --- DEDUPLICATION GEÇMİŞİ ---
-    // Son 20 mesajın PID ve zamanını tutar
-    struct
+    static union
     {
-        pid_t pid;
-        time_t timestamp;
-    } history[20];
-    int history_idx = 0;
+        Message msg;
+        RunRequest run;
+    } in; // Bildirimler ve procx run istekleri aynı tipte (bizim PID'miz) gelir
+    Message *msg = &in.msg;
+    const size_t size = sizeof(in) - sizeof(long);
 
-    // Geçmişi sıfırla
-    memset(history, 0, sizeof(history));
+    memset(g_ipc_history, 0, sizeof(g_ipc_history));
 
     while (1)
     {
-        // Mesajı bekle
-        if (msgrcv(g_mq_id, &msg, sizeof(Message) - sizeof(long), 0, 0) == -1)
+        // Bize gönderilen ilk mesajı bekle
+        if (msgrcv(g_mq_id, &in, size, getpid(), 0) == -1)
         {
             if (errno == EIDRM || errno == EINVAL)
                 break;
@@ -417,54 +1308,731 @@ void *ipc_listener(void *arg)
             continue;
         }
 
-        // Kendi mesajım geldiyse yut
-        if (msg.sender_pid == getpid())
+        // Aynı anda gelen diğerlerini de beklemeden al: bir burst tek pencerede birleşsin
+        do
         {
-            // Diğer terminallerin mesajı kapabilmesi için sıramı savıyorum.
-            usleep(50000); // 50ms bekle
-            continue;
+            // procx run isteğini başlat; kendi mesajımı ve mükerrer mesajları yut, diğerlerini işle
+            if (msg->command == MSG_RUN_REQUEST)
+                handle_run_request(&in.run);
+            else if (msg->sender_pid != getpid() && !is_duplicate_message(msg))
+                show_ipc_message(msg);
+        } while (msgrcv(g_mq_id, &in, size, getpid(), IPC_NOWAIT) != -1);
+
+        // Kuyruk boşaldı; sonraki burst'ü toplamak için her yolda aynı süre bekle
+        usleep(50000); // 50ms bekle
+    }
+    return NULL;
+}
+
+// g_watches'a yeni bir kayıt ekler. Çağıran g_watch_mutex'i tutmalıdır. Tablo doluysa -1 döner.
+static int add_watch_locked(int fd, WatchType type, pid_t pid, unsigned int launch_id, int aux_fd)
+{
+    if (g_watch_count >= MAX_WATCHES)
+        return -1;
+
+    WatchEntry *watch = &g_watches[g_watch_count++];
+    memset(watch, 0, sizeof(*watch));
+    watch->fd = fd;
+    watch->type = type;
+    watch->pid = pid;
+    watch->launch_id = launch_id;
+    watch->aux_fd = aux_fd;
+    return 0;
+}
+
+// fd'ye ait kaydı g_watches'tan çıkarır (fd'yi kapatmaz). Çağıran g_watch_mutex'i tutmalıdır.
+static void remove_watch_locked(int fd)
+{
+    for (int i = 0; i < g_watch_count; i++)
+    {
+        if (g_watches[i].fd == fd)
+        {
+            g_watches[i] = g_watches[g_watch_count - 1];
+            g_watch_count--;
+            return;
         }
+    }
+}
+
+// Event loop'a yeni bir fd ekler ve poll'u uyandırır. Tablo doluysa -1 döner.
+int add_watch(int fd, WatchType type, pid_t pid, unsigned int launch_id, int aux_fd)
+{
+    pthread_mutex_lock(&g_watch_mutex);
+    int rc = add_watch_locked(fd, type, pid, launch_id, aux_fd);
+    pthread_mutex_unlock(&g_watch_mutex);
+    if (rc == -1)
+        return -1;
+
+    // poll'daki thread'in yeni fd'yi görmesi için uyandır
+    if (g_wake_pipe[1] != -1)
+    {
+        char c = 1;
+        write(g_wake_pipe[1], &c, 1);
+    }
+    return 0;
+}
+
+// READY=1 bildirimi pipe'ını timeout_sec saniyelik süreyle event loop'a ekler. Tablo doluysa -1 döner.
+int add_notify_watch(int fd, pid_t pid, unsigned int launch_id, int timeout_sec)
+{
+    pthread_mutex_lock(&g_watch_mutex);
+    int rc = add_watch_locked(fd, WATCH_NOTIFY, pid, launch_id, -1);
+    if (rc == 0)
+    {
+        WatchEntry *watch = &g_watches[g_watch_count - 1];
+        clock_gettime(CLOCK_MONOTONIC, &watch->deadline);
+        watch->deadline.tv_sec += timeout_sec;
+    }
+    pthread_mutex_unlock(&g_watch_mutex);
+    if (rc == -1)
+        return -1;
+
+    // poll'daki thread'in yeni fd'yi ve süresini görmesi için uyandır
+    if (g_wake_pipe[1] != -1)
+    {
+        char c = 1;
+        write(g_wake_pipe[1], &c, 1);
+    }
+    return 0;
+}
 
-        time_t now = time(NULL);
-        int is_duplicate = 0;
+// --- PTY OTURUMLARI ---
 
-        // Geçmişte bu PID için son 2 saniye içinde mesaj gelmiş mi kontrol et
-        for (int i = 0; i < 20; i++)
+// Soket'e MSG_NOSIGNAL ile yazar; karşı taraf kapandıysa SIGPIPE yerine hata döner.
+// Non-blocking sokette yazılamayan kısım atılır (yavaş istemci process'i bekletmez).
+static void send_all(int fd, const char *data, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return;
+        data += n;
+        len -= n;
+    }
+}
+
+// PID'ye ait PTY oturumunu bulur. Çağıran g_watch_mutex'i tutmalıdır.
+static PtySession *find_pty_session(pid_t pid)
+{
+    for (int i = 0; i < MAX_PROCESSES; i++)
+    {
+        if (g_ptys[i].in_use && g_ptys[i].pid == pid)
+            return &g_ptys[i];
+    }
+    return NULL;
+}
+
+// PTY oturumu kaydeder ve master ucunu event loop'a ekler. Tablo doluysa -1 döner.
+int open_pty_session(pid_t pid, int master_fd)
+{
+    pthread_mutex_lock(&g_watch_mutex);
+    PtySession *session = NULL;
+    for (int i = 0; i < MAX_PROCESSES && session == NULL; i++)
+    {
+        if (!g_ptys[i].in_use)
+            session = &g_ptys[i];
+    }
+    if (session == NULL || add_watch_locked(master_fd, WATCH_PTY, pid, 0, -1) == -1)
+    {
+        pthread_mutex_unlock(&g_watch_mutex);
+        return -1;
+    }
+    session->in_use = 1;
+    session->pid = pid;
+    session->master_fd = master_fd;
+    session->client_fd = -1;
+    session->written = 0;
+    pthread_mutex_unlock(&g_watch_mutex);
+
+    // poll'daki thread'in yeni fd'yi görmesi için uyandır
+    char c = 1;
+    write(g_wake_pipe[1], &c, 1);
+    return 0;
+}
+
+// PTY master'ından okur, scrollback'e ekler ve bağlı istemciye iletir.
+// Terminali açık tutan process kalmadıysa (EOF/EIO) oturumu kapatır ve 1, aksi halde 0 döner.
+// Master fd'yi kapatmak çağıranın işidir. Çağıran g_watch_mutex'i tutmalıdır.
+static int read_pty_output(int fd, pid_t pid)
+{
+    PtySession *session = find_pty_session(pid);
+    char data[4096];
+
+    while (1)
+    {
+        ssize_t n = read(fd, data, sizeof(data));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && errno == EAGAIN)
+            return 0;
+        if (n <= 0)
+            break;
+        if (session == NULL)
+            continue;
+
+        // Scrollback halkasına ekle (halka taşarsa en eski çıktının üzerine yazılır)
+        size_t len = n;
+        const char *src = data;
+        if (len > SCROLLBACK_SIZE)
         {
-            if (history[i].pid == msg.target_pid && (now - history[i].timestamp) <= 2)
-            {
-                is_duplicate = 1;
-                break;
-            }
+            src += len - SCROLLBACK_SIZE;
+            len = SCROLLBACK_SIZE;
+        }
+        size_t pos = session->written % SCROLLBACK_SIZE;
+        size_t first = (len < SCROLLBACK_SIZE - pos) ? len : SCROLLBACK_SIZE - pos;
+        memcpy(session->scrollback + pos, src, first);
+        memcpy(session->scrollback, src + first, len - first);
+        session->written += n;
+
+        if (session->client_fd != -1)
+            send_all(session->client_fd, data, n);
+    }
+
+    if (session != NULL)
+    {
+        if (session->client_fd != -1)
+        {
+            const char *bye = "\r\n[ProcX] Process terminali kapandı.\r\n";
+            send_all(session->client_fd, bye, strlen(bye));
+            remove_watch_locked(session->client_fd);
+            close(session->client_fd);
+        }
+        session->in_use = 0;
+    }
+    return 1;
+}
+
+// Bağlı istemciden gelen tuşları PTY'ye yazar. İstemci ayrıldıysa 1, aksi halde 0 döner.
+// Çağıran g_watch_mutex'i tutmalıdır.
+static int read_attach_input(int fd, pid_t pid)
+{
+    char data[1024];
+    ssize_t n = read(fd, data, sizeof(data));
+    if (n < 0 && (errno == EAGAIN || errno == EINTR))
+        return 0;
+
+    PtySession *session = find_pty_session(pid);
+    if (n <= 0)
+    {
+        if (session != NULL && session->client_fd == fd)
+            session->client_fd = -1;
+        return 1;
+    }
+    if (session != NULL)
+        write(session->master_fd, data, n);
+    return 0;
+}
+
+// Unix soketinin karşı ucu bu kullanıcı mı? *peer_pid'e karşı process yazılır
+// (platform vermiyorsa 0). Aynı kullanıcıysa 0, değilse veya okunamazsa -1 döner.
+static int check_peer(int fd, pid_t *peer_pid)
+{
+#ifdef __linux__
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == -1)
+        return -1;
+    *peer_pid = cred.pid;
+    return cred.uid == geteuid() ? 0 : -1;
+#else
+    uid_t uid;
+    gid_t gid;
+    if (getpeereid(fd, &uid, &gid) == -1)
+        return -1;
+    *peer_pid = 0;
+    return uid == geteuid() ? 0 : -1;
+#endif
+}
+
+// Çökmüş instance'lardan kalan attach soketlerini siler (sahibi artık yaşamıyorsa)
+static void remove_stale_attach_sockets()
+{
+    DIR *dir = opendir(g_private_dir);
+    if (dir == NULL)
+        return;
+
+    size_t prefix_len = strlen(ATTACH_SOCK_PREFIX);
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (strncmp(entry->d_name, ATTACH_SOCK_PREFIX, prefix_len) != 0)
+            continue;
+        char *end;
+        long pid = strtol(entry->d_name + prefix_len, &end, 10);
+        if (pid <= 0 || strcmp(end, ".sock") != 0)
+            continue;
+        if (!(kill((pid_t)pid, 0) == -1 && errno == ESRCH))
+            continue; // Sahibi yaşıyor
+
+        char path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+        struct stat st;
+        snprintf(path, sizeof(path), ATTACH_SOCK_FMT, g_private_dir, (int)pid);
+        if (lstat(path, &st) == 0 && S_ISSOCK(st.st_mode) && st.st_uid == geteuid())
+            unlink(path);
+    }
+    closedir(dir);
+}
+
+// Instance'ın attach soketini açar ve event loop'a ekler (yalnızca aynı kullanıcı bağlanabilir).
+// Açılamazsa -1 döner; bu durumda bu instance'ın PTY'lerine attach yapılamaz.
+// Thread'ler başlamadan çağrılmalıdır (umask process geneline uygulanır).
+int open_attach_socket()
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), ATTACH_SOCK_FMT, g_private_dir, getpid());
+
+    remove_stale_attach_sockets();
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1)
+    {
+        perror("Attach soketi oluşturulamadı");
+        return -1;
+    }
+
+    // Soket 0600 doğar: bind ile chmod arasında başkasının bağlanabileceği bir an olmaz
+    unlink(addr.sun_path); // Aynı PID'li eski bir instance'tan kalmış olabilir
+    mode_t old_umask = umask(077);
+    int bound = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+    umask(old_umask);
+    if (fcntl(fd, F_SETFD, FD_CLOEXEC) == -1 ||
+        fcntl(fd, F_SETFL, O_NONBLOCK) == -1 ||
+        bound == -1 ||
+        listen(fd, 8) == -1)
+    {
+        perror("Attach soketi açılamadı");
+        close(fd);
+        if (bound == 0)
+            unlink(addr.sun_path);
+        return -1;
+    }
+    strcpy(g_attach_path, addr.sun_path);
+
+    if (add_watch(fd, WATCH_ATTACH_LISTEN, 0, 0, -1) == -1)
+    {
+        close(fd);
+        unlink(g_attach_path);
+        g_attach_path[0] = '\0';
+        return -1;
+    }
+    g_attach_listen_fd = fd;
+    return 0;
+}
+
+// Bekleyen attach bağlantılarını kabul eder (event loop thread'inden çağrılır).
+// Bağlantı non-blocking yapılır ve istek satırı gelene kadar WATCH_ATTACH_PENDING olarak
+// izlenir; yavaş veya sessiz bir istemci event loop'u bekletemez.
+void accept_attach_client()
+{
+    while (1)
+    {
+        int client = accept(g_attach_listen_fd, NULL, NULL);
+        if (client == -1)
+            return; // EAGAIN: kuyruk boş
+
+        pid_t peer_pid;
+        if (check_peer(client, &peer_pid) == -1 ||
+            fcntl(client, F_SETFD, FD_CLOEXEC) == -1 ||
+            fcntl(client, F_SETFL, O_NONBLOCK) == -1)
+        {
+            close(client); // Başka kullanıcı: cevap bile verilmez
+            continue;
+        }
+#ifdef SO_NOSIGPIPE
+        int one = 1;
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        pthread_mutex_lock(&g_watch_mutex);
+        int rc = add_watch_locked(client, WATCH_ATTACH_PENDING, 0, 0, -1);
+        pthread_mutex_unlock(&g_watch_mutex);
+        if (rc == -1)
+            close(client);
+    }
+}
+
+// Bekleyen attach bağlantısından istek satırını okur. Satır tamamlandıysa 1 (buf'ta,
+// satır sonu olmadan), henüz gelmediyse 0, bağlantı kapandıysa veya satır çok uzunsa -1 döner.
+// Çağıran g_watch_mutex'i tutmalıdır.
+static int read_attach_request(WatchEntry *watch)
+{
+    ssize_t n = read(watch->fd, watch->buf + watch->buf_len, sizeof(watch->buf) - 1 - watch->buf_len);
+    if (n < 0)
+        return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+    if (n == 0)
+        return -1;
+
+    watch->buf_len += n;
+    watch->buf[watch->buf_len] = '\0';
+    char *newline = strchr(watch->buf, '\n');
+    if (newline != NULL)
+    {
+        *newline = '\0';
+        return 1;
+    }
+    return (watch->buf_len >= sizeof(watch->buf) - 1) ? -1 : 0;
+}
+
+// İstek satırı tamamlanan bağlantıyı PTY'ye bağlar (event loop thread'inden çağrılır).
+// İstek satırı: "ATTACH <pid> <satır> <sütun>", cevap "OK\n" veya "ERR <mesaj>\n".
+// OK'den sonra scrollback gönderilir; soket non-blocking olduğu için sığmayan kısım atılır.
+void attach_client(int client, const char *header)
+{
+    int pid, rows, cols;
+    char reply[128];
+    if (sscanf(header, "ATTACH %d %d %d", &pid, &rows, &cols) != 3)
+    {
+        snprintf(reply, sizeof(reply), "ERR Geçersiz istek\n");
+        send_all(client, reply, strlen(reply));
+        close(client);
+        return;
+    }
+
+    pthread_mutex_lock(&g_watch_mutex);
+    PtySession *session = find_pty_session(pid);
+    if (session == NULL)
+        snprintf(reply, sizeof(reply), "ERR PID %d bu instance'ta PTY ile çalışmıyor\n", pid);
+    else if (session->client_fd != -1)
+        snprintf(reply, sizeof(reply), "ERR PID %d'ye başka bir terminal bağlı\n", pid);
+    else if (add_watch_locked(client, WATCH_ATTACH_CLIENT, pid, 0, -1) == -1)
+        snprintf(reply, sizeof(reply), "ERR İzleme tablosu dolu\n");
+    else
+        strcpy(reply, "OK\n");
+    send_all(client, reply, strlen(reply));
+
+    if (reply[0] != 'O')
+    {
+        pthread_mutex_unlock(&g_watch_mutex);
+        close(client);
+        return;
+    }
+
+    // Process'in terminal boyutunu istemcininkine eşitle (SIGWINCH gönderilir)
+    if (rows > 0 && cols > 0)
+    {
+        struct winsize ws;
+        memset(&ws, 0, sizeof(ws));
+        ws.ws_row = rows;
+        ws.ws_col = cols;
+        ioctl(session->master_fd, TIOCSWINSZ, &ws);
+    }
+
+    // Scrollback'i eskiden yeniye gönder
+    if (session->written > SCROLLBACK_SIZE)
+    {
+        size_t pos = session->written % SCROLLBACK_SIZE;
+        send_all(client, session->scrollback + pos, SCROLLBACK_SIZE - pos);
+        send_all(client, session->scrollback, pos);
+    }
+    else
+    {
+        send_all(client, session->scrollback, session->written);
+    }
+
+    session->client_fd = client;
+    pthread_mutex_unlock(&g_watch_mutex);
+}
+
+// Hazır bildirimi pipe'ından okur ve satırları işler.
+// READY=1 geldiyse 1, henüz gelmediyse 0, pipe kapandıysa (child çıktı veya
+// fd'yi kapattı) -1 döner. READY kararı verildikten sonra (ready_decided) gelen
+// STATUS=, WATCHDOG= veya ikinci READY=1 satırları okunup atılır: okuma ucu EOF'a
+// kadar açık kalır ki child'ın sonraki yazmaları SIGPIPE almasın.
+int read_notify(WatchEntry *watch)
+{
+    while (1)
+    {
+        ssize_t n = read(watch->fd, watch->buf + watch->buf_len, sizeof(watch->buf) - 1 - watch->buf_len);
+        if (n == 0)
+            return -1;
+        if (n < 0)
+            return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+        if (watch->ready_decided)
+            continue;
+
+        watch->buf_len += n;
+        watch->buf[watch->buf_len] = '\0';
+
+        // sd_notify formatı: "KEY=VALUE" satırları, biz yalnızca READY=1'e bakıyoruz
+        char *line = watch->buf;
+        char *newline;
+        while ((newline = strchr(line, '\n')) != NULL)
+        {
+            *newline = '\0';
+            if (strcmp(line, "READY=1") == 0)
+                return 1;
+            line = newline + 1;
+        }
+
+        // Yarım kalan satırı başa taşı; tampon dolduysa ve hâlâ satır sonu yoksa at
+        size_t rest = watch->buf_len - (line - watch->buf);
+        if (strcmp(line, "READY=1") == 0)
+            return 1; // Satır sonu olmadan yazıldıysa da kabul et
+        if (rest >= sizeof(watch->buf) - 1)
+            rest = 0;
+        memmove(watch->buf, line, rest);
+        watch->buf_len = rest;
+    }
+}
+
+// Process'i STATUS_STARTING'den STATUS_RUNNING'e geçirir, başlatma gecikmesini kaydeder
+// ve READY olayını tüm instance'lara yayınlar. Gecikmeyi (ms), process bulunamazsa -1 döner.
+// ready 0 ise READY=1 hiç gelmedi: gecikme -1 kalır, olay yayınlanmaz ve 0 döner.
+long mark_process_ready(pid_t pid, int ready)
+{
+    struct timespec now;
+    long latency_ms = -1;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    lock_shared();
+    for (int i = 0; i < g_shared_mem->process_count; i++)
+    {
+        ProcessInfo *proc = &g_shared_mem->processes[i];
+        if (proc->is_active && proc->pid == pid && proc->status == STATUS_STARTING)
+        {
+            latency_ms = ready ? (now.tv_sec - proc->start_mono.tv_sec) * 1000L +
+                                     (now.tv_nsec - proc->start_mono.tv_nsec) / 1000000L
+                               : 0;
+            proc->status = STATUS_RUNNING;
+            proc->ready_latency_ms = ready ? latency_ms : -1;
+            break;
         }
+    }
+    unlock_shared();
+
+    if (latency_ms >= 0 && ready)
+    {
+        // READY olayı: command alanında STATUS_RUNNING'e geçiş olarak taşınır
+        Message msg;
+        msg.command = STATUS_RUNNING;
+        msg.sender_pid = getpid();
+        msg.target_pid = pid;
+        msg.owner_pid = getpid();
+        send_ipc_message(&msg);
+    }
+    return latency_ms;
+}
+
+// READY=1 beklenmekten vazgeçildi (süre doldu, fd kapandı veya izlenemedi):
+// process hâlâ Starting ise ready_latency_ms -1 ile Running'e geçirip bildirir.
+void give_up_ready(pid_t pid, const char *reason)
+{
+    char buffer[256];
+    if (mark_process_ready(pid, 0) == -1)
+        return; // Zaten sonlandı
+
+    snprintf(buffer, sizeof(buffer), "[UYARI] PID %d READY=1 göndermedi (%s), Running sayıldı", pid, reason);
+    post_notice(NOTICE_NOT_READY, getpid(), buffer);
+}
+
+// READY=1 bekleyen bildirim izlerinden en yakın süre dolumuna kaç ms kaldığını döner
+// (-1: bekleyen yok). Event loop bunu poll zaman aşımına katar.
+int notify_timeout_ms()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
 
-        if (is_duplicate)
+    pthread_mutex_lock(&g_watch_mutex);
+    long timeout = -1;
+    for (int i = 0; i < g_watch_count; i++)
+    {
+        const WatchEntry *watch = &g_watches[i];
+        if (watch->type != WATCH_NOTIFY || watch->ready_decided)
+            continue;
+        long left = (watch->deadline.tv_sec - now.tv_sec) * 1000L +
+                    (watch->deadline.tv_nsec - now.tv_nsec) / 1000000L + 1; // Aşağı yuvarlamayı telafi et
+        if (left < 0)
+            left = 0;
+        if (timeout < 0 || left < timeout)
+            timeout = left;
+    }
+    pthread_mutex_unlock(&g_watch_mutex);
+    return (int)timeout;
+}
+
+// Süresi dolan READY beklemelerini kapatır. İz, child fd'yi kapatana kadar yutmaya devam eder.
+void expire_notify_watches()
+{
+    pid_t expired[MAX_WATCHES];
+    int expired_count = 0;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&g_watch_mutex);
+    for (int i = 0; i < g_watch_count; i++)
+    {
+        WatchEntry *watch = &g_watches[i];
+        if (watch->type != WATCH_NOTIFY || watch->ready_decided)
+            continue;
+        if (now.tv_sec > watch->deadline.tv_sec ||
+            (now.tv_sec == watch->deadline.tv_sec && now.tv_nsec >= watch->deadline.tv_nsec))
         {
-            continue; // Mükerrer mesajı yut
+            watch->ready_decided = 1;
+            watch->buf_len = 0;
+            expired[expired_count++] = watch->pid;
         }
+    }
+    pthread_mutex_unlock(&g_watch_mutex);
+
+    // Shared memory kilidi watch mutex'i dışında alınır
+    for (int i = 0; i < expired_count; i++)
+        give_up_ready(expired[i], "süre doldu");
+}
+
+// Event Loop Thread fonksiyonu
+// Tek bir poll çağrısıyla child'ların exec durum ve hazır bildirimi pipe'larını,
+// PTY master uçlarını ve attach bağlantılarını izler.
+// Yeni fd eklendiğinde add_watch wake pipe'ına yazarak poll'u uyandırır.
+void *event_loop(void *arg)
+{
+    (void)arg; // Makefile unused parameter warning go away
+    struct pollfd fds[MAX_WATCHES + 1];
+    char buffer[256];
 
-        // Yeni mesajı geçmişe ekle
-        history[history_idx].pid = msg.target_pid;
-        history[history_idx].timestamp = now;
-        history_idx = (history_idx + 1) % 20; // Dairesel döngü
+    while (1)
+    {
+        // İzlenen fd listesini kopyala (poll sırasında mutex tutulmaz)
+        fds[0].fd = g_wake_pipe[0];
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
 
-        // Başkasından gelen mesajı işle
-        if (msg.command == STATUS_TERMINATED)
+        pthread_mutex_lock(&g_watch_mutex);
+        int nfds = 1;
+        for (int i = 0; i < g_watch_count; i++)
         {
-            snprintf(buffer, sizeof(buffer), "[IPC] Process sonlandırıldı: PID %d", msg.target_pid);
+            fds[nfds].fd = g_watches[i].fd;
+            fds[nfds].events = (g_watches[i].type == WATCH_PSI) ? POLLPRI : POLLIN; // PSI trigger'ları POLLPRI ile bildirir
+            fds[nfds].revents = 0;
+            nfds++;
         }
-        else if (msg.command == STATUS_CREATED)
+        pthread_mutex_unlock(&g_watch_mutex);
+
+        // Bekleyen bildirim varsa penceresi, kısılan istek varsa throttle aralığı,
+        // READY bekleyen process varsa süresi dolunca uyan
+        int timeout = notice_timeout_ms();
+        int deferred_timeout = deferred_timeout_ms();
+        if (deferred_timeout >= 0 && (timeout < 0 || deferred_timeout < timeout))
+            timeout = deferred_timeout;
+        int ready_timeout = notify_timeout_ms();
+        if (ready_timeout >= 0 && (timeout < 0 || ready_timeout < timeout))
+            timeout = ready_timeout;
+        if (poll(fds, nfds, timeout) == -1)
         {
-            snprintf(buffer, sizeof(buffer), "[IPC] Yeni process başlatıldı: PID %d", msg.target_pid);
+            if (errno != EINTR)
+                perror("poll hatası");
+            continue;
         }
 
-        // Ekrana bas
-        repaint_ui(buffer);
+        flush_notices();
+        if (deferred_timeout_ms() == 0)
+            resume_deferred();
+        if (ready_timeout >= 0)
+            expire_notify_watches();
 
-        // Açgözlülük Önleme:
-        // Mesajı aldım, işimi bitirdim. Kuyrukta başka kopya varsa
-        // onları diğer terminaller alsın diye biraz bekliyorum.
-        usleep(50000); // 50ms bekle
+        // Uyandırma baytlarını boşalt
+        if (fds[0].revents & POLLIN)
+        {
+            char drain[64];
+            while (read(g_wake_pipe[0], drain, sizeof(drain)) > 0)
+                ;
+        }
+
+        for (int f = 1; f < nfds; f++)
+        {
+            if (fds[f].revents == 0)
+                continue;
+
+            pthread_mutex_lock(&g_watch_mutex);
+            int idx = -1;
+            for (int i = 0; i < g_watch_count; i++)
+            {
+                if (g_watches[i].fd == fds[f].fd)
+                {
+                    idx = i;
+                    break;
+                }
+            }
+            if (idx == -1)
+            {
+                pthread_mutex_unlock(&g_watch_mutex);
+                continue;
+            }
+
+            WatchEntry *watch = &g_watches[idx];
+            WatchType type = watch->type;
+            pid_t pid = watch->pid;
+            unsigned int launch_id = watch->launch_id;
+            int aux_fd = watch->aux_fd;
+            int child_err = 0;
+            int result = 0;
+            int ready_decided = watch->ready_decided;
+            char request[sizeof(watch->buf)];
+            if (type == WATCH_EXEC)
+                result = read_exec_status(watch->fd, &child_err);
+            else if (type == WATCH_NOTIFY)
+            {
+                result = read_notify(watch);
+                if (result == 1)
+                {
+                    // İz EOF'a kadar kalır, sonraki satırlar yutulur
+                    watch->ready_decided = 1;
+                    watch->buf_len = 0;
+                }
+            }
+            else if (type == WATCH_PTY)
+                result = read_pty_output(fds[f].fd, pid);
+            else if (type == WATCH_ATTACH_CLIENT)
+                result = read_attach_input(fds[f].fd, pid);
+            else if (type == WATCH_ATTACH_PENDING && (result = read_attach_request(watch)) == 1)
+                memcpy(request, watch->buf, sizeof(request));
+            else if (type == WATCH_PSI && (fds[f].revents & (POLLERR | POLLNVAL)))
+                result = 1; // Trigger geçersizleşti
+            if (type == WATCH_NOTIFY ? result == -1 : result != 0)
+            {
+                // Sonuç belli oldu veya fd kapandı: artık izlemeye gerek yok.
+                // read_pty_output başka kayıtları silmiş olabilir, index yerine fd ile çıkar.
+                // İstek satırı tamamlanan attach bağlantısı açık kalır (attach_client'a geçer).
+                if (!(type == WATCH_ATTACH_PENDING && result == 1))
+                    close(fds[f].fd);
+                remove_watch_locked(fds[f].fd);
+            }
+            pthread_mutex_unlock(&g_watch_mutex);
+
+            // Bildirimler mutex dışında işlenir (finish_spawn yeniden add_watch çağırabilir)
+            if (type == WATCH_ATTACH_LISTEN)
+            {
+                accept_attach_client();
+            }
+            else if (type == WATCH_ATTACH_PENDING && result == 1)
+            {
+                attach_client(fds[f].fd, request);
+            }
+            else if (type == WATCH_PSI && result == 0 && (fds[f].revents & POLLPRI))
+            {
+                psi_event(aux_fd);
+            }
+            else if (type == WATCH_EXEC && result != 0)
+            {
+                finish_spawn(pid, launch_id, aux_fd, result, child_err);
+            }
+            else if (type == WATCH_NOTIFY && result == 1)
+            {
+                long latency_ms = mark_process_ready(pid, 1);
+                if (latency_ms >= 0)
+                {
+                    snprintf(buffer, sizeof(buffer), "[READY] Process hazır: PID %d (%ld ms)", pid, latency_ms);
+                    post_notice(NOTICE_READY, getpid(), buffer);
+                }
+            }
+            else if (type == WATCH_NOTIFY && result == -1 && !ready_decided)
+            {
+                give_up_ready(pid, "bildirim fd'si kapandı");
+            }
+        }
     }
     return NULL;
 }
@@ -485,291 +2053,3936 @@ int parse_command(char *command, char *argv[])
     return count;
 }
 
-// Yeni process oluşturma fonksiyonu
-void create_new_process(char *command, ProcessMode mode)
+// "512M", "2G", "1024" (MB) gibi boyutları MB cinsine çevirir. Hatalıysa -1 döner.
+static long parse_size_mb(const char *str)
 {
-    char command_for_tokenize[256];
-    char command_for_save[256];
-    pid_t pid;
+    char *end;
+    long value = strtol(str, &end, 10);
+    if (end == str || value < 0)
+        return -1;
 
-    // komutları kopyala
-    strncpy(command_for_tokenize, command, sizeof(command_for_tokenize) - 1);
-    command_for_tokenize[sizeof(command_for_tokenize) - 1] = '\0';
+    if (*end == '\0' || strcmp(end, "M") == 0 || strcmp(end, "m") == 0)
+        return value;
+    if (strcmp(end, "G") == 0 || strcmp(end, "g") == 0)
+        return value * 1024;
+    if (strcmp(end, "K") == 0 || strcmp(end, "k") == 0)
+        return value / 1024 > 0 ? value / 1024 : 1;
+    return -1;
+}
+
+// Tam sayı argümanı okur, aralık dışıysa veya sayı değilse -1 döner
+static int parse_ranged_int(const char *str, long min, long max, long *out)
+{
+    char *end;
+    long value = strtol(str, &end, 10);
+    if (end == str || *end != '\0' || value < min || value > max)
+        return -1;
+    *out = value;
+    return 0;
+}
 
-    strncpy(command_for_save, command, sizeof(command_for_save) - 1);
-    command_for_save[sizeof(command_for_save) - 1] = '\0';
+// Başlatma seçeneklerini ayrıştırır:
+//   --profile NAME  --nice N  --ioprio CLASS[:LEVEL]  --oom N
+//   --mem SIZE  --nofile N  --cpu SEC  --notify  --ready-timeout SEC  --pty
+// Seçenek olmayan ilk argümanın indexini, hatada -1 döner.
+int parse_launch_options(int argc, char *argv[], LaunchOptions *opts)
+{
+    int explicit_options = 0;
+    int notify_ready = 0;
+    int use_pty = 0;
+    long ready_timeout = 30;
+    const char *profile = NULL;
+    LaunchOptions overrides;
+    int set_mask = 0; // Hangi alanların açıkça verildiği
+    memset(&overrides, 0, sizeof(overrides));
 
-    // Yeni process oluşturmadan önce parent ve child arasında bir pipe oluştur
-    // Eğer child process hemen sonlanırsa (execvp başarısız olursa) parent bunu anlayabilir
-    int pipe_fd[2];
-    if (pipe(pipe_fd) == -1)
+    int i = 0;
+    for (; i < argc; i++)
     {
-        perror("Pipe oluşturulamadı");
-        return;
-    }
+        const char *opt = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        long num;
+
+        if (strcmp(opt, "--") == 0)
+        {
+            i++;
+            break;
+        }
+        if (strncmp(opt, "--", 2) != 0)
+            break;
+        if (strcmp(opt, "--notify") == 0)
+        {
+            // Değer almayan bayrak, profil seçimini etkilemez
+            notify_ready = 1;
+            continue;
+        }
+        if (strcmp(opt, "--pty") == 0)
+        {
+            use_pty = 1;
+            continue;
+        }
+        if (val == NULL)
+        {
+            fprintf(stderr, "[HATA] %s bir değer bekliyor.\n", opt);
+            return -1;
+        }
+
+        if (strcmp(opt, "--profile") == 0)
+        {
+            profile = val;
+        }
+        else if (strcmp(opt, "--ready-timeout") == 0 && parse_ranged_int(val, 1, 86400, &num) == 0)
+        {
+            ready_timeout = num;
+            i++;
+            continue;
+        }
+        else if (strcmp(opt, "--nice") == 0 && parse_ranged_int(val, -20, 19, &num) == 0)
+        {
+            overrides.nice = (int)num;
+            set_mask |= 1 << 0;
+        }
+        else if (strcmp(opt, "--ioprio") == 0)
+        {
+            char cls[16];
+            const char *colon = strchr(val, ':');
+            size_t cls_len = colon ? (size_t)(colon - val) : strlen(val);
+            if (cls_len >= sizeof(cls))
+                cls_len = sizeof(cls) - 1;
+            memcpy(cls, val, cls_len);
+            cls[cls_len] = '\0';
+
+            if (strcmp(cls, "rt") == 0 || strcmp(cls, "realtime") == 0)
+                overrides.ioprio_class = IOPRIO_CLASS_RT;
+            else if (strcmp(cls, "be") == 0 || strcmp(cls, "best-effort") == 0)
+                overrides.ioprio_class = IOPRIO_CLASS_BE;
+            else if (strcmp(cls, "idle") == 0)
+                overrides.ioprio_class = IOPRIO_CLASS_IDLE;
+            else
+            {
+                fprintf(stderr, "[HATA] Geçersiz I/O sınıfı: %s (rt, be, idle)\n", cls);
+                return -1;
+            }
+
+            overrides.ioprio_level = 4; // Kernel'in best-effort varsayılanı
+            if (colon != NULL && parse_ranged_int(colon + 1, 0, 7, &num) == 0)
+                overrides.ioprio_level = (int)num;
+            else if (colon != NULL)
+            {
+                fprintf(stderr, "[HATA] I/O seviyesi 0-7 arasında olmalı.\n");
+                return -1;
+            }
+            set_mask |= 1 << 1;
+        }
+        else if (strcmp(opt, "--oom") == 0 && parse_ranged_int(val, -1000, 1000, &num) == 0)
+        {
+            overrides.oom_score_adj = (int)num;
+            set_mask |= 1 << 2;
+        }
+        else if (strcmp(opt, "--mem") == 0 && (num = parse_size_mb(val)) >= 0)
+        {
+            overrides.mem_limit_mb = num;
+            set_mask |= 1 << 3;
+        }
+        else if (strcmp(opt, "--nofile") == 0 && parse_ranged_int(val, 1, 1L << 20, &num) == 0)
+        {
+            overrides.nofile_limit = num;
+            set_mask |= 1 << 4;
+        }
+        else if (strcmp(opt, "--cpu") == 0 && parse_ranged_int(val, 1, 1L << 30, &num) == 0)
+        {
+            overrides.cpu_limit_sec = num;
+            set_mask |= 1 << 5;
+        }
+        else
+        {
+            fprintf(stderr, "[HATA] Geçersiz seçenek veya değer: %s %s\n", opt, val);
+            return -1;
+        }
+        explicit_options = 1;
+        i++; // Değeri atla
+    }
+
+    // Önce profili uygula, sonra açık seçeneklerle ez
+    memset(opts, 0, sizeof(*opts));
+    strcpy(opts->profile, "default");
+    if (profile != NULL)
+    {
+        size_t n;
+        for (n = 0; n < sizeof(g_profiles) / sizeof(g_profiles[0]); n++)
+        {
+            if (strcmp(g_profiles[n].profile, profile) == 0)
+            {
+                *opts = g_profiles[n];
+                break;
+            }
+        }
+        if (n == sizeof(g_profiles) / sizeof(g_profiles[0]))
+        {
+            fprintf(stderr, "[HATA] Bilinmeyen profil: %s (default, service, batch, idle)\n", profile);
+            return -1;
+        }
+    }
+    else if (explicit_options)
+    {
+        strcpy(opts->profile, "custom");
+    }
+
+    const LaunchOptions base = *opts;
+    if (set_mask & (1 << 0))
+        opts->nice = overrides.nice;
+    if (set_mask & (1 << 1))
+    {
+        opts->ioprio_class = overrides.ioprio_class;
+        opts->ioprio_level = overrides.ioprio_level;
+    }
+    if (set_mask & (1 << 2))
+        opts->oom_score_adj = overrides.oom_score_adj;
+    if (set_mask & (1 << 3))
+        opts->mem_limit_mb = overrides.mem_limit_mb;
+    if (set_mask & (1 << 4))
+        opts->nofile_limit = overrides.nofile_limit;
+    if (set_mask & (1 << 5))
+        opts->cpu_limit_sec = overrides.cpu_limit_sec;
+
+    // Açık seçenek profilin bir alanını değiştirdiyse etiket artık profili tam yansıtmaz
+    if (profile != NULL &&
+        (opts->nice != base.nice || opts->ioprio_class != base.ioprio_class ||
+         opts->ioprio_level != base.ioprio_level || opts->oom_score_adj != base.oom_score_adj ||
+         opts->mem_limit_mb != base.mem_limit_mb || opts->nofile_limit != base.nofile_limit ||
+         opts->cpu_limit_sec != base.cpu_limit_sec))
+    {
+        strcat(opts->profile, "+");
+    }
+
+    opts->notify_ready = notify_ready;
+    opts->ready_timeout_sec = (int)ready_timeout;
+    opts->use_pty = use_pty;
+    return i;
+}
+
+// Başlatma seçeneklerini çağıran process'e uygular (child'da exec öncesi çağrılır).
+// Başarılıysa 0, aksi halde errno değerini döner.
+int apply_launch_options(const LaunchOptions *opts)
+{
+    struct rlimit rl;
+
+    if (opts->mem_limit_mb > 0)
+    {
+        rl.rlim_cur = rl.rlim_max = (rlim_t)opts->mem_limit_mb * 1024 * 1024;
+        if (setrlimit(RLIMIT_AS, &rl) == -1)
+            return errno;
+    }
+    if (opts->nofile_limit > 0)
+    {
+        rl.rlim_cur = rl.rlim_max = (rlim_t)opts->nofile_limit;
+        if (setrlimit(RLIMIT_NOFILE, &rl) == -1)
+            return errno;
+    }
+    if (opts->cpu_limit_sec > 0)
+    {
+        // Soft limitte SIGXCPU gelir, process kapanmazsa 1 saniye sonra SIGKILL
+        rl.rlim_cur = (rlim_t)opts->cpu_limit_sec;
+        rl.rlim_max = (rlim_t)opts->cpu_limit_sec + 1;
+        if (setrlimit(RLIMIT_CPU, &rl) == -1)
+            return errno;
+    }
+    if (opts->nice != 0)
+    {
+        if (setpriority(PRIO_PROCESS, 0, opts->nice) == -1)
+            return errno;
+    }
+    if (opts->ioprio_class != IOPRIO_CLASS_NONE)
+    {
+#ifdef __linux__
+        int level = opts->ioprio_class == IOPRIO_CLASS_IDLE ? 0 : opts->ioprio_level;
+        if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0,
+                    IOPRIO_PRIO_VALUE(opts->ioprio_class, level)) == -1)
+            return errno;
+#else
+        return ENOTSUP;
+#endif
+    }
+    if (opts->oom_score_adj != 0)
+    {
+#ifdef __linux__
+        char value[16];
+        int len = snprintf(value, sizeof(value), "%d", opts->oom_score_adj);
+        int fd = open("/proc/self/oom_score_adj", O_WRONLY);
+        if (fd == -1)
+            return errno;
+        if (write(fd, value, len) != len)
+        {
+            int err = errno;
+            close(fd);
+            return err;
+        }
+        close(fd);
+#else
+        return ENOTSUP;
+#endif
+    }
+    return 0;
+}
+
+// Listeleme için I/O sınıfının kısa adı
+static const char *ioprio_class_name(IoPrioClass cls)
+{
+    switch (cls)
+    {
+    case IOPRIO_CLASS_RT:
+        return "rt";
+    case IOPRIO_CLASS_BE:
+        return "be";
+    case IOPRIO_CLASS_IDLE:
+        return "idle";
+    default:
+        return "-";
+    }
+}
+
+// Process tablosunda yeni bir process için yer ayırır (pid henüz 0, STATUS_CREATED).
+// Böylece paralel başlatmalar exec sonucunu beklerken tablo dolmaz veya taşmaz.
+// Ayrılan kaydın launch_id'sini, tablo doluysa 0 döner.
+unsigned int reserve_slot(const char *command, ProcessMode mode, const LaunchOptions *opts,
+                          unsigned int schedule_id)
+{
+    lock_shared();
+
+    if (g_shared_mem->process_count >= MAX_PROCESSES)
+    {
+        unlock_shared();
+        return 0;
+    }
+
+    ProcessInfo *new_proc = &g_shared_mem->processes[g_shared_mem->process_count];
+    memset(new_proc, 0, sizeof(*new_proc));
+
+    // 0 "kayıt yok" anlamına geldiği için atla
+    if (++g_shared_mem->next_launch_id == 0)
+        g_shared_mem->next_launch_id = 1;
+    new_proc->launch_id = g_shared_mem->next_launch_id;
+
+    new_proc->pid = 0;
+    new_proc->owner_pid = getpid();
+    new_proc->mode = mode;
+    new_proc->status = STATUS_CREATED; // exec sonucu bekleniyor
+
+    // Kaydedilen orijinal komutu kopyala
+    strncpy(new_proc->command, command, sizeof(new_proc->command) - 1);
+    new_proc->command[sizeof(new_proc->command) - 1] = '\0';
+
+    new_proc->start_time = time(NULL);
+    new_proc->ready_latency_ms = -1;
+    new_proc->schedule_id = schedule_id;
+    new_proc->is_active = 1;
+
+    if (opts != NULL)
+        new_proc->launch = *opts;
+    else
+        strcpy(new_proc->launch.profile, "default");
+
+    g_shared_mem->process_count++;
+    unsigned int launch_id = new_proc->launch_id;
+
+    unlock_shared();
+    return launch_id;
+}
+
+// launch_id'ye ait kaydı bulur. Çağıran shared memory kilidini tutmalıdır.
+ProcessInfo *find_slot(unsigned int launch_id)
+{
+    for (int i = 0; i < g_shared_mem->process_count; i++)
+    {
+        ProcessInfo *proc = &g_shared_mem->processes[i];
+        if (proc->is_active && proc->launch_id == launch_id && proc->owner_pid == getpid())
+            return proc;
+    }
+    return NULL;
+}
+
+// fork sonrası child'ın PID'sini ayrılan kayda yazar
+void set_slot_pid(unsigned int launch_id, pid_t pid, const struct timespec *start_mono)
+{
+    lock_shared();
+    ProcessInfo *proc = find_slot(launch_id);
+    if (proc != NULL)
+    {
+        proc->pid = pid;
+        proc->start_mono = *start_mono;
+    }
+    unlock_shared();
+}
+
+// Ayrılan kaydı serbest bırakır (başlatma başarısız oldu).
+// Monitor thread'i inaktif kaydı bir sonraki taramada tablodan siler.
+void release_slot(unsigned int launch_id)
+{
+    lock_shared();
+    ProcessInfo *proc = find_slot(launch_id);
+    if (proc != NULL)
+    {
+        proc->is_active = 0;
+        proc->status = STATUS_TERMINATED;
+    }
+    unlock_shared();
+}
+
+// exec başarılı oldu: kaydı Running (veya hazır bildirimi bekleniyorsa Starting)
+// durumuna geçirir ve diğer instance'lara bildirir. Kayıttaki READY bekleme süresini döner.
+int commit_slot(unsigned int launch_id, pid_t pid, int await_ready)
+{
+    int ready_timeout_sec = 0;
+    lock_shared();
+    ProcessInfo *proc = find_slot(launch_id);
+    if (proc != NULL)
+    {
+        proc->status = await_ready ? STATUS_STARTING : STATUS_RUNNING;
+        ready_timeout_sec = proc->launch.ready_timeout_sec;
+
+        // Zamanlanmış görevin son başlattığı process'i güncelle
+        for (int i = 0; proc->schedule_id != 0 && i < g_shared_mem->schedule_high; i++)
+        {
+            ScheduleInfo *sched = &g_shared_mem->schedules[i];
+            if (sched->in_use && sched->id == proc->schedule_id)
+            {
+                sched->last_pid = pid;
+                break;
+            }
+        }
+    }
+    unlock_shared();
+
+    // IPC Bildirimi Gönder
+    Message ipc_msg;
+    ipc_msg.command = STATUS_CREATED;
+    ipc_msg.sender_pid = getpid();
+    ipc_msg.target_pid = pid;
+    ipc_msg.owner_pid = getpid();
+    send_ipc_message(&ipc_msg);
+    return ready_timeout_sec;
+}
+
+// Her iki ucu da close-on-exec olan bir pipe açar; flags'e O_NONBLOCK verilirse iki uç da
+// non-blocking olur. Linux'ta bayrak pipe2 ile atomik konur, böylece başka bir spawner
+// thread'inin aynı anda yaptığı fork/exec uçları miras alamaz.
+static int pipe_cloexec(int fds[2], int flags)
+{
+#ifdef __linux__
+    return pipe2(fds, O_CLOEXEC | flags);
+#else
+    // pipe2 yok: bayraklar hemen ardından konur (arada fork eden thread uçları görebilir)
+    if (pipe(fds) == -1)
+        return -1;
+    for (int i = 0; i < 2; i++)
+    {
+        if (fcntl(fds[i], F_SETFD, FD_CLOEXEC) == -1 ||
+            ((flags & O_NONBLOCK) && fcntl(fds[i], F_SETFL, O_NONBLOCK) == -1))
+        {
+            close(fds[0]);
+            close(fds[1]);
+            return -1;
+        }
+    }
+    return 0;
+#endif
+}
+
+// Child'ın ortamını fork'tan önce hazırlar: ProcX'in ortamı, NOTIFY_ENV yerine notify_fd'nin
+// numarası (-1 ise NOTIFY_ENV hiç olmaz, ProcX'e miras kalan değer sızmaz). Child'da setenv (malloc) çağrılmaz; başka bir thread'in tuttuğu malloc kilidiyle
+// fork edilen child orada kilitlenebilirdi. Dizi ve yeni değişken tek blokta döner (free ile
+// bırakılır), bellek yetmezse NULL döner.
+static char **build_child_env(int notify_fd)
+{
+    size_t count = 0;
+    while (environ[count] != NULL)
+        count++;
+
+    char **envp = malloc((count + 2) * sizeof(char *) + 32);
+    if (envp == NULL)
+        return NULL;
+    char *notify_var = (char *)(envp + count + 2);
+
+    size_t n = 0;
+    const size_t prefix_len = strlen(NOTIFY_ENV "=");
+    for (size_t i = 0; i < count; i++)
+    {
+        if (strncmp(environ[i], NOTIFY_ENV "=", prefix_len) != 0)
+            envp[n++] = environ[i];
+    }
+    if (notify_fd != -1)
+    {
+        snprintf(notify_var, 32, NOTIFY_ENV "=%d", notify_fd);
+        envp[n++] = notify_var;
+    }
+    envp[n] = NULL;
+    return envp;
+}
+
+// Child process'i fork eder ve exec'e gönderir, exec sonucunu beklemez.
+// exec_argv verildiyse olduğu gibi exec edilir (tırnaklı argümanlar korunur); NULL ise
+// command boşluklardan bölünür. command her durumda tabloda görünen addır.
+// *exec_fd: exec başarılıysa EOF, başarısızsa errno okunan pipe'ın okuma ucu (non-blocking).
+// *notify_fd: opts->notify_ready verildiyse hazır bildirimi pipe'ının okuma ucu, aksi halde -1.
+// *pty_fd: opts->use_pty verildiyse PTY'nin master ucu (non-blocking), aksi halde -1.
+// Başarılıysa child'ın PID'sini, aksi halde -1 döner.
+pid_t fork_child(char *command, char *const exec_argv[], const char *cwd, ProcessMode mode, const LaunchOptions *opts,
+                 int *exec_fd, int *notify_fd, int *pty_fd, struct timespec *start_mono)
+{
+    char command_for_tokenize[256];
+    char *argv[MAX_ARGS];
+    char *const *exec_args = exec_argv;
+    char **envp;
+    pid_t pid;
+    int notify_pipe[2] = {-1, -1};
+    int pty_master = -1;
+    int pty_slave = -1;
+
+    *exec_fd = -1;
+    *notify_fd = -1;
+    *pty_fd = -1;
+
+    // komutu kopyala
+    strncpy(command_for_tokenize, command, sizeof(command_for_tokenize) - 1);
+    command_for_tokenize[sizeof(command_for_tokenize) - 1] = '\0';
+
+    // Argüman vektörü verilmediyse komutu fork'tan önce tokenize et
+    int arg_count = 1;
+    if (exec_args == NULL)
+    {
+        arg_count = parse_command(command_for_tokenize, argv);
+        exec_args = argv;
+    }
+
+    // Yeni process oluşturmadan önce parent ve child arasında bir pipe oluştur
+    // Eğer child process hemen sonlanırsa (execvp başarısız olursa) parent bunu anlayabilir
+    // İki uç da close-on-exec doğar. Yazma ucu execvp başarılı olursa kapanır, ikisi de
+    // aynı anda fork edilen diğer child'lara sızmaz (sızan yazma ucu EOF'u geciktirirdi).
+    // Non-blocking: event loop exec sonucunu poll ile bekler, child yalnızca 4 bayt yazar.
+    int pipe_fd[2];
+    if (pipe_cloexec(pipe_fd, O_NONBLOCK) == -1)
+    {
+        perror("Pipe oluşturulamadı");
+        return -1;
+    }
+
+    // Hazır bildirimi istendiyse ikinci bir pipe aç.
+    // İki uç da close-on-exec doğar; child yalnızca yazma ucunu bu bayraktan kurtarır,
+    // böylece aynı anda fork edilen diğer child'lara sızmaz. Yazma ucu blocking kalır
+    // (child'ın göreceği fd), okuma ucu event loop için non-blocking yapılır.
+    if (opts != NULL && opts->notify_ready)
+    {
+        if (pipe_cloexec(notify_pipe, 0) == -1)
+            notify_pipe[0] = notify_pipe[1] = -1;
+        if (notify_pipe[0] == -1 || fcntl(notify_pipe[0], F_SETFL, O_NONBLOCK) == -1)
+        {
+            perror("Bildirim pipe'ı oluşturulamadı");
+            if (notify_pipe[0] != -1)
+            {
+                close(notify_pipe[0]);
+                close(notify_pipe[1]);
+            }
+            close(pipe_fd[0]);
+            close(pipe_fd[1]);
+            return -1;
+        }
+    }
+
+    // Bildirim yazma ucunun numarası child'ın ortamında yayınlanır
+    envp = build_child_env(notify_pipe[1]);
+    if (envp == NULL)
+    {
+        perror("Child ortamı hazırlanamadı");
+        if (notify_pipe[0] != -1)
+        {
+            close(notify_pipe[0]);
+            close(notify_pipe[1]);
+        }
+        close(pipe_fd[0]);
+        close(pipe_fd[1]);
+        return -1;
+    }
+
+    // PTY istendiyse master/slave çiftini aç. Slave child'da stdin/stdout/stderr olur,
+    // master ProcX'te kalır ve event loop tarafından okunur.
+    if (opts != NULL && opts->use_pty)
+    {
+        char slave_name[64];
+#ifdef __linux__
+        pty_master = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC); // Bayrak açılışta, arada fork sızmaz
+#else
+        pty_master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (pty_master != -1 && fcntl(pty_master, F_SETFD, FD_CLOEXEC) == -1)
+        {
+            close(pty_master);
+            pty_master = -1;
+        }
+#endif
+        if (pty_master == -1 ||
+            fcntl(pty_master, F_SETFL, O_NONBLOCK) == -1 ||
+            grantpt(pty_master) == -1 ||
+            unlockpt(pty_master) == -1 ||
+            ptsname_r(pty_master, slave_name, sizeof(slave_name)) != 0 ||
+            (pty_slave = open(slave_name, O_RDWR | O_NOCTTY | O_CLOEXEC)) == -1)
+        {
+            perror("PTY açılamadı");
+            if (pty_master != -1)
+                close(pty_master);
+            if (notify_pipe[0] != -1)
+            {
+                close(notify_pipe[0]);
+                close(notify_pipe[1]);
+            }
+            close(pipe_fd[0]);
+            close(pipe_fd[1]);
+            free(envp);
+            return -1;
+        }
+    }
+
+    // Başlatma gecikmesi bu andan itibaren ölçülür
+    clock_gettime(CLOCK_MONOTONIC, start_mono);
+
+    // Yeni process oluştur
+    pid = fork();
+
+    if (pid < 0)
+    {
+        perror("Fork hatası");
+        // Pipe'ı kapat
+        close(pipe_fd[0]);
+        close(pipe_fd[1]);
+        if (notify_pipe[0] != -1)
+        {
+            close(notify_pipe[0]);
+            close(notify_pipe[1]);
+        }
+        if (pty_master != -1)
+        {
+            close(pty_master);
+            close(pty_slave);
+        }
+        free(envp);
+        return -1;
+    }
+
+    // --- CHILD PROCESS ---
+    // Buradan exec'e kadar yalnızca async-signal-safe çağrılar: argv ve ortam parent'ta hazırlandı
+    else if (pid == 0)
+    {
+        // Pipe'ın okuma ucunu kapat
+        close(pipe_fd[0]);
+
+        if (arg_count == 0 || exec_args[0] == NULL)
+        {
+            // Hata durumunda pipe'a yaz
+            int err = ENOENT;
+            write(pipe_fd[1], &err, sizeof(err));
+            exit(EXIT_FAILURE);
+        }
+
+        // PTY'nin kontrol terminali olabilmesi için child yeni bir oturum açmalı
+        if (mode == MODE_DETACHED || pty_slave != -1)
+        {
+            if (setsid() < 0)
+            {
+                // Hata durumunda pipe'a yaz
+                int err = errno;
+                write(pipe_fd[1], &err, sizeof(err));
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        // PTY slave'ini kontrol terminali ve standart fd'ler yap
+        if (pty_slave != -1)
+        {
+            close(pty_master);
+            if (ioctl(pty_slave, TIOCSCTTY, 0) == -1 ||
+                dup2(pty_slave, STDIN_FILENO) == -1 ||
+                dup2(pty_slave, STDOUT_FILENO) == -1 ||
+                dup2(pty_slave, STDERR_FILENO) == -1)
+            {
+                int err = errno;
+                write(pipe_fd[1], &err, sizeof(err));
+                exit(EXIT_FAILURE);
+            }
+            close(pty_slave);
+        }
+
+        // procx run isteğinde child, komutu veren terminalin dizininde başlar
+        if (cwd != NULL && cwd[0] != '\0' && chdir(cwd) == -1)
+        {
+            int err = errno;
+            write(pipe_fd[1], &err, sizeof(err));
+            exit(EXIT_FAILURE);
+        }
+
+        // Kaynak sınırlarını ve öncelikleri exec'ten önce uygula
+        if (opts != NULL)
+        {
+            int err = apply_launch_options(opts);
+            if (err != 0)
+            {
+                write(pipe_fd[1], &err, sizeof(err));
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        // Hazır bildirimi fd'sini exec sonrasına aktar (numarası envp'de)
+        if (notify_pipe[1] != -1)
+        {
+            close(notify_pipe[0]);
+            if (fcntl(notify_pipe[1], F_SETFD, 0) == -1)
+            {
+                int err = errno;
+                write(pipe_fd[1], &err, sizeof(err));
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        // Programı çalıştır (argv[0] komutun kendisidir)
+#ifdef __linux__
+        execvpe(exec_args[0], exec_args, envp);
+#else
+        environ = envp; // Yalnızca işaretçi ataması, execvp bu ortamı kullanır
+        execvp(exec_args[0], exec_args);
+#endif
+
+        // Buraya gelindiyse execvp başarısız olmuştur
+        int err = errno;
+        write(pipe_fd[1], &err, sizeof(err)); // Parent'a hata kodunu yaz
+
+        // Pipe'ın yazma ucunu kapat
+        close(pipe_fd[1]);
+
+        // Hata durumunda (Komut bulunamazsa)
+        perror("execvp hatası (Komut bulunamadı veya çalıştırılamadı)");
+        exit(EXIT_FAILURE);
+    }
+
+    // --- PARENT PROCESS  ---
+
+    // Child ortamın kopyasını aldı
+    free(envp);
+
+    // Yazma uçlarını kapat, okuma uçlarını çağırana ver
+    close(pipe_fd[1]);
+    if (notify_pipe[1] != -1)
+    {
+        close(notify_pipe[1]);
+    }
+    // Slave yalnızca child'da açık kalmalı, yoksa child çıkınca master EOF görmez
+    if (pty_slave != -1)
+    {
+        close(pty_slave);
+    }
+
+    *exec_fd = pipe_fd[0];
+    *notify_fd = notify_pipe[0];
+    *pty_fd = pty_master;
+    return pid;
+}
+
+// Exec durum pipe'ından okur. Child exec edildiyse (EOF) 1, exec başarısız olduysa
+// 2 (*child_err'e errno yazılır), sonuç henüz belli değilse 0 döner.
+int read_exec_status(int fd, int *child_err)
+{
+    ssize_t n = read(fd, child_err, sizeof(*child_err));
+    if (n > 0)
+        return 2;
+    if (n == 0)
+        return 1;
+    if (errno == EAGAIN || errno == EINTR)
+        return 0;
+    *child_err = errno;
+    return 2;
+}
+
+// Başlatma isteğini kuyruğa ekler. Kuyruk doluysa -1 döner.
+int submit_spawn(const char *command, ProcessMode mode, const LaunchOptions *opts, unsigned int schedule_id)
+{
+    pthread_mutex_lock(&g_spawn_mutex);
+    if (g_spawn_queue_len >= SPAWN_QUEUE_SIZE)
+    {
+        pthread_mutex_unlock(&g_spawn_mutex);
+        return -1;
+    }
+
+    SpawnRequest *req = &g_spawn_queue[(g_spawn_queue_head + g_spawn_queue_len) % SPAWN_QUEUE_SIZE];
+    strncpy(req->command, command, sizeof(req->command) - 1);
+    req->command[sizeof(req->command) - 1] = '\0';
+    req->mode = mode;
+    req->schedule_id = schedule_id;
+    req->deferred = 0;
+    if (opts != NULL)
+        req->opts = *opts;
+    else
+    {
+        memset(&req->opts, 0, sizeof(req->opts));
+        strcpy(req->opts.profile, "default");
+    }
+    g_spawn_queue_len++;
+
+    pthread_cond_signal(&g_spawn_cond);
+    pthread_mutex_unlock(&g_spawn_mutex);
+    return 0;
+}
+
+// procx run isteğinin sonucunu isteyen CLI'a gönderir (pid başlatılan process, error 0 değilse errno)
+static void send_run_reply(pid_t reply_pid, pid_t pid, int error)
+{
+    if (kill(reply_pid, 0) == -1 && errno == ESRCH)
+        return; // CLI beklemekten vazgeçip çıkmış, cevap kuyrukta kalmasın
+
+    Message msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_type = reply_pid;
+    msg.command = MSG_RUN_REPLY;
+    msg.sender_pid = getpid();
+    msg.target_pid = pid;
+    msg.owner_pid = getpid();
+    msg.error = error;
+    msgsnd(g_mq_id, &msg, sizeof(Message) - sizeof(long), IPC_NOWAIT);
+}
+
+// launch_id'nin sonucunu bekleyen procx run'ı listeden çıkarır (yoksa 0 döner)
+static pid_t take_run_reply(unsigned int launch_id)
+{
+    pid_t reply_pid = 0;
+    pthread_mutex_lock(&g_spawn_mutex);
+    for (int i = 0; i < g_run_reply_count; i++)
+    {
+        if (g_run_replies[i].launch_id == launch_id)
+        {
+            reply_pid = g_run_replies[i].reply_pid;
+            g_run_replies[i] = g_run_replies[--g_run_reply_count];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_spawn_mutex);
+    return reply_pid;
+}
+
+// Exec sonucu belli olduğunda (event loop veya spawner thread'den) çağrılır.
+// result: read_exec_status dönüşü (1: başarılı, 2: başarısız)
+void finish_spawn(pid_t pid, unsigned int launch_id, int notify_fd, int result, int child_err)
+{
+    char buffer[256];
+    pid_t reply_pid;
+
+    if (result == 2)
+    {
+        // Child errno'yu yazıp çıkıyor; event loop'u bekletmemek için WNOHANG.
+        // Henüz çıkmadıysa monitor thread'i sonraki tikte toplar (zombi kalmaz).
+        if (waitpid(pid, NULL, WNOHANG) == 0)
+        {
+            pthread_mutex_lock(&g_spawn_mutex);
+            int queued = (g_reap_count < SPAWN_QUEUE_SIZE);
+            if (queued)
+                g_reap_pids[g_reap_count++] = pid;
+            pthread_mutex_unlock(&g_spawn_mutex);
+            if (!queued)
+                waitpid(pid, NULL, 0); // Liste dolu (çok nadir): eski davranış
+        }
+        release_slot(launch_id);
+        if (notify_fd != -1)
+            close(notify_fd);
+
+        snprintf(buffer, sizeof(buffer), "[HATA] Process başlatılamadı: PID %d (Hata Kodu: %d, %s)",
+                 pid, child_err, strerror(child_err));
+        post_notice(NOTICE_FAILED, getpid(), buffer);
+        if ((reply_pid = take_run_reply(launch_id)) != 0)
+            send_run_reply(reply_pid, 0, child_err);
+        return;
+    }
+
+    int ready_timeout_sec = commit_slot(launch_id, pid, notify_fd != -1);
+
+    // READY=1 bildirimini de event loop bekler; izlenemezse process Starting'de kalmasın
+    if (notify_fd != -1 && add_notify_watch(notify_fd, pid, launch_id, ready_timeout_sec) == -1)
+    {
+        close(notify_fd);
+        notify_fd = -1;
+        give_up_ready(pid, "izleme tablosu dolu");
+    }
+
+    snprintf(buffer, sizeof(buffer), "[SUCCESS] Process başlatıldı: PID %d%s",
+             pid, notify_fd != -1 ? " (READY bekleniyor)" : "");
+    post_notice(NOTICE_STARTED, getpid(), buffer);
+    if ((reply_pid = take_run_reply(launch_id)) != 0)
+        send_run_reply(reply_pid, pid, 0);
+}
+
+// finish_spawn'ın hemen toplayamadığı (exec'i başarısız) child'ları toplar. Monitor tikinden çağrılır.
+void reap_failed_children()
+{
+    pthread_mutex_lock(&g_spawn_mutex);
+    int kept = 0;
+    for (int i = 0; i < g_reap_count; i++)
+    {
+        if (waitpid(g_reap_pids[i], NULL, WNOHANG) == 0)
+            g_reap_pids[kept++] = g_reap_pids[i];
+    }
+    g_reap_count = kept;
+    pthread_mutex_unlock(&g_spawn_mutex);
+}
+
+// --- BASKIYA GÖRE KABUL KONTROLÜ (PSI) ---
+
+// Baskı maskesini "memory,io" biçiminde yazar
+static void pressure_names(unsigned int mask, char *buf, size_t size)
+{
+    buf[0] = '\0';
+    for (int i = 0; i < PSI_RESOURCES; i++)
+    {
+        if (mask & (1u << i))
+        {
+            size_t len = strlen(buf);
+            snprintf(buf + len, size - len, "%s%s", len > 0 ? "," : "", g_psi[i].name);
+        }
+    }
+}
+
+// /proc/pressure/<name> dosyasından "some avg10" değerini okur. Okunamazsa -1 döner.
+static double read_psi_avg10(const char *name)
+{
+    char path[64];
+    double avg10 = -1;
+    snprintf(path, sizeof(path), "/proc/pressure/%s", name);
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return -1;
+    if (fscanf(file, "some avg10=%lf", &avg10) != 1)
+        avg10 = -1;
+    fclose(file);
+    return avg10;
+}
+
+// Son PSI_HOLD_SEC saniye içinde tetiklenen kaynakların maskesi.
+// Çağıran g_spawn_mutex'i tutmalıdır.
+static unsigned int current_pressure_mask(const struct timespec *now)
+{
+    unsigned int mask = 0;
+    for (int i = 0; i < PSI_RESOURCES; i++)
+    {
+        const struct timespec *last = &g_psi[i].last_event;
+        if ((last->tv_sec != 0 || last->tv_nsec != 0) && now->tv_sec - last->tv_sec < PSI_HOLD_SEC)
+            mask |= 1u << i;
+    }
+    return mask;
+}
+
+// PROCX_PSI ortam değişkenini okur, ör. "cpu=90,memory=20,io=0,detached-first=0,throttle=500".
+// "off" tüm izlemeyi kapatır; eşik 0 olan kaynak izlenmez.
+static void parse_psi_config()
+{
+    const char *env = getenv(PSI_ENV);
+    if (env == NULL)
+        return;
+    if (strcmp(env, "off") == 0)
+    {
+        for (int i = 0; i < PSI_RESOURCES; i++)
+            g_psi[i].threshold_pct = 0;
+        return;
+    }
+
+    char config[256];
+    strncpy(config, env, sizeof(config) - 1);
+    config[sizeof(config) - 1] = '\0';
+
+    for (char *item = strtok(config, ","); item != NULL; item = strtok(NULL, ","))
+    {
+        char *eq = strchr(item, '=');
+        long num;
+        if (eq == NULL)
+        {
+            fprintf(stderr, "[HATA] %s: geçersiz öğe '%s' (yok sayıldı)\n", PSI_ENV, item);
+            continue;
+        }
+        *eq = '\0';
+
+        int found = 0;
+        for (int i = 0; i < PSI_RESOURCES; i++)
+        {
+            if (strcmp(item, g_psi[i].name) == 0 && parse_ranged_int(eq + 1, 0, 100, &num) == 0)
+            {
+                g_psi[i].threshold_pct = (int)num;
+                found = 1;
+            }
+        }
+        if (!found && strcmp(item, "detached-first") == 0 && parse_ranged_int(eq + 1, 0, 1, &num) == 0)
+            g_psi_detached_first = (int)num, found = 1;
+        else if (!found && strcmp(item, "throttle") == 0 && parse_ranged_int(eq + 1, 0, 3600000, &num) == 0)
+            g_psi_throttle_ms = num, found = 1;
+
+        if (!found)
+            fprintf(stderr, "[HATA] %s: geçersiz öğe '%s=%s' (yok sayıldı)\n", PSI_ENV, item, eq + 1);
+    }
+}
+
+// PSI trigger'larını kurar ve event loop'a ekler (yalnızca Linux 4.20+).
+// Trigger kurulamayan kaynak izlenmez; hiçbiri kurulamazsa başlatmalar hiç bekletilmez.
+void init_psi()
+{
+    parse_psi_config();
+#ifdef __linux__
+    for (int i = 0; i < PSI_RESOURCES; i++)
+    {
+        if (g_psi[i].threshold_pct == 0)
+            continue;
+
+        // "some <stall_us> <window_us>": pencerede en az stall_us kadar bekleyen görev olursa POLLPRI
+        char path[64];
+        char trigger[64];
+        snprintf(path, sizeof(path), "/proc/pressure/%s", g_psi[i].name);
+        snprintf(trigger, sizeof(trigger), "some %ld %d",
+                 (long)PSI_WINDOW_US / 100 * g_psi[i].threshold_pct, PSI_WINDOW_US);
+
+        int fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (fd == -1 || write(fd, trigger, strlen(trigger) + 1) == -1)
+        {
+            fprintf(stderr, "[HATA] PSI trigger'ı kurulamadı (%s): %s\n", path, strerror(errno));
+            if (fd != -1)
+                close(fd);
+            continue;
+        }
+        if (add_watch(fd, WATCH_PSI, 0, 0, i) == -1)
+        {
+            close(fd);
+            continue;
+        }
+        g_psi[i].fd = fd;
+    }
+#endif
+}
+
+// Event loop bir PSI trigger'ı tetiklendiğinde çağırır
+void psi_event(int resource)
+{
+    char buffer[256];
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&g_spawn_mutex);
+    g_psi[resource].last_event = now;
+    int newly = !(g_pressure_mask & (1u << resource));
+    g_pressure_mask |= 1u << resource;
+    unsigned int mask = g_pressure_mask;
+    pthread_mutex_unlock(&g_spawn_mutex);
+
+    if (!newly)
+        return;
+
+    lock_shared();
+    g_shared_mem->admission.pressure_mask = mask;
+    g_shared_mem->admission.last_pressure = time(NULL);
+    unlock_shared();
+
+    // avg10 trigger penceresinden yavaş güncellendiği için mesajda eşik gösterilir
+    snprintf(buffer, sizeof(buffer), "[PSI] %s baskısı eşiği aştı (%d sn pencerede >%%%d bekleme): başlatmalar %s",
+             g_psi[resource].name, PSI_WINDOW_US / 1000000, g_psi[resource].threshold_pct,
+             g_psi_detached_first ? "kısılıyor, Detached işler erteleniyor" : "kısılıyor");
+    post_notice(NOTICE_PSI, getpid(), buffer);
+}
+
+// İsteğin şimdi başlatılıp başlatılamayacağına karar verir; bekletilecekse g_deferred'a ekler.
+// Çağıran g_spawn_mutex'i tutmalıdır.
+static AdmissionDecision admit_spawn_locked(SpawnRequest *req, unsigned int *mask)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    *mask = current_pressure_mask(&now);
+
+    AdmissionDecision decision = ADMIT_OK;
+    if (*mask != 0)
+    {
+        long since_last_ms = (now.tv_sec - g_last_admit.tv_sec) * 1000L +
+                             (now.tv_nsec - g_last_admit.tv_nsec) / 1000000L;
+        if (req->mode == MODE_DETACHED && g_psi_detached_first)
+            decision = ADMIT_DEFERRED;
+        else if (since_last_ms < g_psi_throttle_ms)
+            decision = ADMIT_THROTTLED;
+    }
+
+    if (decision == ADMIT_OK)
+    {
+        g_last_admit = now;
+        return ADMIT_OK;
+    }
+    if (g_deferred_len >= SPAWN_QUEUE_SIZE)
+        return ADMIT_DROPPED;
+
+    SpawnRequest *slot = &g_deferred[g_deferred_len++];
+    *slot = *req;
+    if (slot->deferred == 0)
+    {
+        slot->deferred = decision;
+        slot->deferred_at = time(NULL);
+    }
+    return decision;
+}
+
+// Kabul kararını sayaçlara işler ve bildirir. İstek daha önce de bekletildiyse
+// tekrar sayılmaz; sonunda başlatılınca "resumed" olarak sayılır.
+static void note_admission(const SpawnRequest *req, AdmissionDecision decision, unsigned int mask)
+{
+    char buffer[256];
+    char names[32];
+    pressure_names(mask, names, sizeof(names));
+
+    if ((decision == ADMIT_DEFERRED || decision == ADMIT_THROTTLED) && req->deferred != 0)
+        return; // Hâlâ bekliyor, zaten sayıldı
+
+    NoticeKind kind = (decision == ADMIT_DROPPED) ? NOTICE_FAILED : NOTICE_PSI;
+    lock_shared();
+    AdmissionStats *stats = &g_shared_mem->admission;
+    if (decision == ADMIT_DEFERRED)
+    {
+        stats->deferred_total++;
+        stats->waiting++;
+        snprintf(buffer, sizeof(buffer), "[PSI] Başlatma ertelendi (%s baskısı, Detached): %.64s", names, req->command);
+    }
+    else if (decision == ADMIT_THROTTLED)
+    {
+        stats->throttled_total++;
+        stats->waiting++;
+        snprintf(buffer, sizeof(buffer), "[PSI] Başlatma kısıldı (%s baskısı, %ld ms aralıkla): %.64s",
+                 names, g_psi_throttle_ms, req->command);
+    }
+    else if (decision == ADMIT_DROPPED)
+    {
+        stats->dropped_total++;
+        if (req->deferred != 0)
+            stats->waiting--;
+        snprintf(buffer, sizeof(buffer), "[HATA] Erteleme kuyruğu dolu (%d istek), başlatma düşürüldü: %.64s",
+                 SPAWN_QUEUE_SIZE, req->command);
+    }
+    else
+    {
+        stats->resumed_total++;
+        stats->waiting--;
+        snprintf(buffer, sizeof(buffer), "[PSI] Bekletilen istek başlatılıyor (%lds bekledi): %.64s",
+                 (long)(time(NULL) - req->deferred_at), req->command);
+    }
+    unlock_shared();
+    post_notice(kind, getpid(), buffer);
+}
+
+// Hız sınırına takılan bir isteğin başlatılabilmesine kaç ms kaldığını döner (-1: yok).
+// Event loop bunu poll zaman aşımına katar; böylece 1 sn'den kısa throttle değerleri
+// monitor'ün saniyelik turuna yuvarlanmaz. Erteleme (Detached) baskı geçene kadar sürer,
+// spawner kuyruğu doluysa da yer açılması monitor'e bırakılır.
+int deferred_timeout_ms()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&g_spawn_mutex);
+    int timeout = -1;
+    if (g_spawn_queue_len < SPAWN_QUEUE_SIZE)
+    {
+        for (int i = 0; i < g_deferred_len; i++)
+        {
+            if (g_pressure_mask != 0 && g_deferred[i].mode == MODE_DETACHED && g_psi_detached_first)
+                continue;
+            long since_last_ms = (now.tv_sec - g_last_admit.tv_sec) * 1000L +
+                                 (now.tv_nsec - g_last_admit.tv_nsec) / 1000000L;
+            long left = g_psi_throttle_ms - since_last_ms;
+            timeout = left < 0 ? 0 : (int)left + 1; // Aşağı yuvarlamayı telafi et
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_spawn_mutex);
+    return timeout;
+}
+
+// Monitor thread'inden saniyede bir, hız sınırı aralığı dolunca da event loop'tan çağrılır.
+// Baskı geçtiyse tüm bekletilen istekleri, sürüyorsa yalnızca hız sınırına takılanları
+// spawner kuyruğuna geri verir.
+void resume_deferred()
+{
+    char buffer[256];
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&g_spawn_mutex);
+    unsigned int mask = current_pressure_mask(&now);
+    int cleared = (g_pressure_mask != 0 && mask == 0);
+    g_pressure_mask = mask;
+
+    int kept = 0;
+    int moved = 0;
+    for (int i = 0; i < g_deferred_len; i++)
+    {
+        SpawnRequest *req = &g_deferred[i];
+        int hold = (mask != 0 && req->mode == MODE_DETACHED && g_psi_detached_first);
+        if (!hold && g_spawn_queue_len < SPAWN_QUEUE_SIZE)
+        {
+            g_spawn_queue[(g_spawn_queue_head + g_spawn_queue_len) % SPAWN_QUEUE_SIZE] = *req;
+            g_spawn_queue_len++;
+            moved++;
+        }
+        else
+        {
+            g_deferred[kept++] = *req;
+        }
+    }
+    g_deferred_len = kept;
+    if (moved > 0)
+        pthread_cond_broadcast(&g_spawn_cond);
+    pthread_mutex_unlock(&g_spawn_mutex);
+
+    if (!cleared)
+        return;
+
+    lock_shared();
+    g_shared_mem->admission.pressure_mask = 0;
+    unlock_shared();
+
+    snprintf(buffer, sizeof(buffer), "[PSI] Baskı geçti, %d bekletilen istek yeniden kuyruğa alındı", moved);
+    post_notice(NOTICE_PSI, getpid(), buffer);
+}
+
+// pthread_cleanup_push için mutex bırakma sarmalayıcısı
+static void unlock_mutex_cleanup(void *mutex)
+{
+    pthread_mutex_unlock((pthread_mutex_t *)mutex);
+}
+
+// Spawner Thread fonksiyonu
+// Kuyruktan istek alır, tabloda yer ayırır ve fork/exec yapar. Exec sonucunu
+// beklemez; durum pipe'ını event loop'a verip sıradaki isteğe geçer. Böylece
+// SPAWNER_THREADS kadar thread ile çok sayıda child aynı anda başlatılabilir.
+void *spawner_thread(void *arg)
+{
+    (void)arg; // Makefile unused parameter warning go away
+    SpawnRequest req;
+
+    while (1)
+    {
+        pthread_mutex_lock(&g_spawn_mutex);
+        // pthread_cancel cond_wait içinde gelirse mutex'i geri alıp çıkar;
+        // diğer spawner'lar takılmasın diye mutex'i bırak
+        pthread_cleanup_push(unlock_mutex_cleanup, &g_spawn_mutex);
+        while (g_spawn_queue_len == 0)
+        {
+            pthread_cond_wait(&g_spawn_cond, &g_spawn_mutex);
+        }
+        req = g_spawn_queue[g_spawn_queue_head];
+        g_spawn_queue_head = (g_spawn_queue_head + 1) % SPAWN_QUEUE_SIZE;
+        g_spawn_queue_len--;
+        pthread_cleanup_pop(1); // Mutex'i bırak
+
+        // Sistem baskı altındaysa isteği beklet; UI ve diğer spawner'lar beklemez
+        unsigned int mask;
+        pthread_mutex_lock(&g_spawn_mutex);
+        AdmissionDecision decision = admit_spawn_locked(&req, &mask);
+        pthread_mutex_unlock(&g_spawn_mutex);
+        if (decision != ADMIT_OK || req.deferred != 0)
+            note_admission(&req, decision, mask);
+        if (decision != ADMIT_OK)
+            continue;
+
+        launch_child(req.command, NULL, NULL, req.mode, &req.opts, req.schedule_id, 0);
+    }
+    return NULL;
+}
+
+// Tabloda yer ayırıp child'ı fork eder ve exec sonucunu event loop'a bırakır (spawner'lar ve
+// procx run istekleri için ortak yol). exec_argv NULL ise komut tokenize edilir, cwd NULL ise
+// child ProcX'in dizininde başlar. reply_pid verildiyse sonuç o procx run'a bildirilir.
+void launch_child(const char *command, char *const exec_argv[], const char *cwd, ProcessMode mode,
+                  const LaunchOptions *opts, unsigned int schedule_id, pid_t reply_pid)
+{
+    char buffer[256];
+    char command_copy[256];
+    snprintf(command_copy, sizeof(command_copy), "%s", command);
+
+    unsigned int launch_id = reserve_slot(command_copy, mode, opts, schedule_id);
+    if (launch_id == 0)
+    {
+        snprintf(buffer, sizeof(buffer), "[HATA] Shared memory dolu (Maksimum %d sürece ulaşıldı): %.64s",
+                 MAX_PROCESSES, command_copy);
+        post_notice(NOTICE_FAILED, getpid(), buffer);
+        if (reply_pid != 0)
+            send_run_reply(reply_pid, 0, ENOSPC);
+        return;
+    }
+
+    // Sonuç event loop'ta fork'tan hemen sonra belli olabilir: bekleyen cevabı önce kaydet
+    if (reply_pid != 0)
+    {
+        pthread_mutex_lock(&g_spawn_mutex);
+        int full = (g_run_reply_count >= SPAWN_QUEUE_SIZE);
+        if (!full)
+        {
+            g_run_replies[g_run_reply_count].launch_id = launch_id;
+            g_run_replies[g_run_reply_count].reply_pid = reply_pid;
+            g_run_reply_count++;
+        }
+        pthread_mutex_unlock(&g_spawn_mutex);
+        if (full)
+        {
+            release_slot(launch_id);
+            send_run_reply(reply_pid, 0, EBUSY);
+            return;
+        }
+    }
+
+    int exec_fd, notify_fd, pty_fd;
+    struct timespec start_mono;
+    pid_t pid = fork_child(command_copy, exec_argv, cwd, mode, opts, &exec_fd, &notify_fd, &pty_fd, &start_mono);
+    if (pid < 0)
+    {
+        int err = errno;
+        release_slot(launch_id);
+        if (take_run_reply(launch_id) != 0)
+            send_run_reply(reply_pid, 0, err != 0 ? err : EAGAIN);
+        return;
+    }
+    set_slot_pid(launch_id, pid, &start_mono);
+
+    // PTY çıktısı exec'ten önce bile gelebilir, master'ı hemen event loop'a ver.
+    // Oturum tablosu doluysa master kapanır ve child SIGHUP alır.
+    if (pty_fd != -1 && open_pty_session(pid, pty_fd) == -1)
+    {
+        close(pty_fd);
+        snprintf(buffer, sizeof(buffer), "[HATA] PTY oturumu açılamadı: PID %d", pid);
+        post_notice(NOTICE_FAILED, getpid(), buffer);
+    }
+
+    // Exec sonucunu event loop toplasın
+    if (add_watch(exec_fd, WATCH_EXEC, pid, launch_id, notify_fd) == 0)
+        return;
+
+    // İzleme tablosu doluysa sonucu burada bekle
+    struct pollfd pfd = {exec_fd, POLLIN, 0};
+    int child_err = 0;
+    int result;
+    while ((result = read_exec_status(exec_fd, &child_err)) == 0)
+    {
+        poll(&pfd, 1, -1);
+    }
+    close(exec_fd);
+    finish_spawn(pid, launch_id, notify_fd, result, child_err);
+}
+
+// procx run isteğini işler (listener thread'inden). Process bu instance'a ait olur: monitor
+// wait4 ile toplar, çıkış kodu ve rusage geçmişe yazılır. procx run kabul kontrolünden geçmez.
+void handle_run_request(const RunRequest *req)
+{
+    char args[RUN_ARGS_SIZE];
+    char *exec_argv[RUN_MAX_ARGS + 1];
+    memcpy(args, req->args, sizeof(args));
+    args[sizeof(args) - 1] = '\0';
+
+    // NUL ile ayrılmış argümanları vektöre çevir
+    int argc = 0;
+    size_t pos = 0;
+    while (argc < req->argc && argc < RUN_MAX_ARGS && pos < sizeof(args) - 1)
+    {
+        exec_argv[argc++] = args + pos;
+        pos += strlen(args + pos) + 1;
+    }
+    exec_argv[argc] = NULL;
+    if (argc == 0 || argc != req->argc)
+    {
+        send_run_reply(req->sender_pid, 0, EINVAL);
+        return;
+    }
+
+    char display[256];
+    snprintf(display, sizeof(display), "%s", req->display);
+    LaunchOptions opts = req->opts;
+    opts.use_pty = 0; // procx run --pty'yi zaten reddeder
+    launch_child(display, exec_argv, req->cwd, MODE_DETACHED, &opts, 0, req->sender_pid);
+}
+
+// Menüden yeni process oluşturma fonksiyonu
+// İsteği spawner kuyruğuna ekler ve hemen döner; sonuç bildirim olarak gelir.
+void create_new_process(char *command, ProcessMode mode, const LaunchOptions *opts)
+{
+    if (submit_spawn(command, mode, opts, 0) == -1)
+    {
+        fprintf(stderr, "[HATA] Başlatma kuyruğu dolu (%d istek bekliyor).\n", SPAWN_QUEUE_SIZE);
+        return;
+    }
+
+    pthread_mutex_lock(&g_ui_mutex);
+    printf("[INFO] Başlatma isteği kuyruğa alındı (Mod: %s, Profil: %s)\n",
+           (mode == MODE_DETACHED ? "Detached" : "Attached"),
+           opts != NULL ? opts->profile : "default");
+    fflush(stdout);
+    pthread_mutex_unlock(&g_ui_mutex);
+}
+
+// --- ZAMANLAYICI (TIMER WHEEL) ---
+
+// Cron alanını ("*", "5", "1-5", "*/15", "0,30", "10-50/10") bit maskesine çevirir.
+// Hatalıysa -1 döner.
+static int parse_cron_field(const char *field, int min, int max, unsigned long long *mask)
+{
+    char copy[64];
+    char *save = NULL;
+
+    strncpy(copy, field, sizeof(copy) - 1);
+    copy[sizeof(copy) - 1] = '\0';
+    *mask = 0;
+
+    for (char *item = strtok_r(copy, ",", &save); item != NULL; item = strtok_r(NULL, ",", &save))
+    {
+        long lo = min, hi = max, step = 1;
+        char *slash = strchr(item, '/');
+        char *end;
+
+        if (slash != NULL)
+        {
+            *slash = '\0';
+            step = strtol(slash + 1, &end, 10);
+            if (*end != '\0' || step <= 0)
+                return -1;
+        }
+
+        if (strcmp(item, "*") != 0)
+        {
+            lo = strtol(item, &end, 10);
+            if (end == item)
+                return -1;
+            hi = lo;
+            if (*end == '-')
+            {
+                char *range_end = end + 1;
+                hi = strtol(range_end, &end, 10);
+                if (end == range_end)
+                    return -1;
+            }
+            if (*end != '\0')
+                return -1;
+            if (slash != NULL && hi == lo)
+                hi = max; // "5/10" -> 5'ten başlayarak her 10'da bir
+        }
+
+        if (lo < min || hi > max || lo > hi)
+            return -1;
+        for (long v = lo; v <= hi; v += step)
+            *mask |= 1ULL << v;
+    }
+    return *mask != 0 ? 0 : -1;
+}
+
+// "dakika saat gün ay haftanın_günü" biçimindeki cron ifadesini ayrıştırır
+int parse_cron(const char *expr, CronSpec *spec)
+{
+    char copy[64];
+    char *fields[5];
+    char *save = NULL;
+    int count = 0;
+    unsigned long long mask;
+
+    strncpy(copy, expr, sizeof(copy) - 1);
+    copy[sizeof(copy) - 1] = '\0';
+
+    for (char *tok = strtok_r(copy, " \t", &save); tok != NULL; tok = strtok_r(NULL, " \t", &save))
+    {
+        if (count == 5)
+            return -1;
+        fields[count++] = tok;
+    }
+    if (count != 5)
+        return -1;
+
+    memset(spec, 0, sizeof(*spec));
+    if (parse_cron_field(fields[0], 0, 59, &spec->minutes) == -1)
+        return -1;
+    if (parse_cron_field(fields[1], 0, 23, &mask) == -1)
+        return -1;
+    spec->hours = (unsigned int)mask;
+    if (parse_cron_field(fields[2], 1, 31, &mask) == -1)
+        return -1;
+    spec->days = (unsigned int)mask;
+    if (parse_cron_field(fields[3], 1, 12, &mask) == -1)
+        return -1;
+    spec->months = (unsigned short)mask;
+    if (parse_cron_field(fields[4], 0, 7, &mask) == -1)
+        return -1;
+    if (mask & (1ULL << 7))
+        mask |= 1; // 7 = Pazar = 0
+    spec->weekdays = (unsigned char)(mask & 0x7F);
+
+    // Standart cron: gün ve haftanın günü ikisi de kısıtlıysa biri eşleşmesi yeter
+    spec->dom_restricted = strcmp(fields[2], "*") != 0;
+    spec->dow_restricted = strcmp(fields[4], "*") != 0;
+    return 0;
+}
+
+// after'dan sonraki ilk eşleşen dakikayı (yerel saat) bulur. Bulamazsa 0 döner.
+// Eşleşmeyen ay/gün/saat bütün olarak atlandığı için döngü kısa sürer.
+time_t next_cron_time(const CronSpec *spec, time_t after)
+{
+    struct tm tm;
+    time_t t = after - (after % 60) + 60; // Bir sonraki tam dakika
+    localtime_r(&t, &tm);
+    tm.tm_sec = 0;
+
+    for (int guard = 0; guard < 5 * 366 * 24; guard++)
+    {
+        if (!(spec->months & (1U << (tm.tm_mon + 1))))
+        {
+            tm.tm_mon++;
+            tm.tm_mday = 1;
+            tm.tm_hour = 0;
+            tm.tm_min = 0;
+        }
+        else
+        {
+            int dom_match = (spec->days >> tm.tm_mday) & 1;
+            int dow_match = (spec->weekdays >> tm.tm_wday) & 1;
+            int day_match = (spec->dom_restricted && spec->dow_restricted) ? (dom_match || dow_match)
+                                                                            : (dom_match && dow_match);
+            if (!day_match)
+            {
+                tm.tm_mday++;
+                tm.tm_hour = 0;
+                tm.tm_min = 0;
+            }
+            else if (!((spec->hours >> tm.tm_hour) & 1))
+            {
+                tm.tm_hour++;
+                tm.tm_min = 0;
+            }
+            else
+            {
+                // Saat uygun, ilk eşleşen dakikayı ara
+                while (tm.tm_min < 60 && !((spec->minutes >> tm.tm_min) & 1))
+                    tm.tm_min++;
+                if (tm.tm_min < 60)
+                    return mktime(&tm);
+                tm.tm_hour++;
+                tm.tm_min = 0;
+            }
+        }
+
+        // Taşan alanları (ör. 32 Ocak) normalize et
+        tm.tm_isdst = -1;
+        t = mktime(&tm);
+        localtime_r(&t, &tm);
+    }
+    return 0;
+}
+
+// Zamanlayıcının bir sonraki çalışma zamanını hesaplar (now'dan sonra).
+// Tek seferlik görevler için 0 döner.
+static time_t schedule_next_after(const ScheduleInfo *sched, time_t now)
+{
+    if (sched->kind == SCHED_FIXED_RATE)
+    {
+        // Sabit oran: kaymayı önlemek için bir önceki planlanan zamana ekle,
+        // geride kaldıysak kaçırılan çalıştırmaları atla
+        time_t next = sched->next_run + sched->interval_sec;
+        if (next <= now)
+            next += ((now - next) / sched->interval_sec + 1) * sched->interval_sec;
+        return next;
+    }
+    if (sched->kind == SCHED_CRON)
+        return next_cron_time(&sched->cron, now);
+    return 0;
+}
+
+// Görevi wheel'deki listesinden çıkarır (O(1))
+static void wheel_unlink(int idx)
+{
+    TimerWheel *w = &g_wheel;
+    if (!w->armed[idx])
+        return;
+
+    int level = w->level[idx], slot = w->slot[idx];
+    if (w->prev[idx] != -1)
+        w->next[w->prev[idx]] = w->next[idx];
+    else
+        w->head[level][slot] = w->next[idx];
+    if (w->next[idx] != -1)
+        w->prev[w->next[idx]] = w->prev[idx];
+    w->armed[idx] = 0;
+}
+
+// Görevi bitiş zamanına göre uygun seviye ve slota ekler (O(1)).
+// Seviye 0 saniyelik, her üst seviye bir alttakinin tam turu kadar aralıklıdır.
+static void wheel_insert(int idx, time_t expires)
+{
+    TimerWheel *w = &g_wheel;
+    long long delta = (long long)(expires - w->now);
+    int level;
+
+    if (delta <= 0)
+    {
+        // Geçmiş zaman: bir sonraki tick'te çalışsın
+        expires = w->now + 1;
+        delta = 1;
+    }
+
+    if (delta >= 1LL << (WHEEL_BITS * WHEEL_LEVELS))
+    {
+        // Wheel kapsamının dışı: en üst seviyenin son slotuna koy, cascade'de tekrar yerleşir
+        delta = (1LL << (WHEEL_BITS * WHEEL_LEVELS)) - 1;
+    }
+
+    for (level = 0; level < WHEEL_LEVELS - 1; level++)
+    {
+        if (delta < 1LL << (WHEEL_BITS * (level + 1)))
+            break;
+    }
+
+    time_t slot_time = w->now + delta;
+    int slot = (int)((slot_time >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1));
+
+    w->expires[idx] = expires;
+    w->level[idx] = (unsigned char)level;
+    w->slot[idx] = (unsigned char)slot;
+    w->prev[idx] = -1;
+    w->next[idx] = w->head[level][slot];
+    if (w->next[idx] != -1)
+        w->prev[w->next[idx]] = idx;
+    w->head[level][slot] = idx;
+    w->armed[idx] = 1;
+}
+
+// Görev tablosundaki idx kaydının değiştiğini zamanlayıcıya bildirir (schedule_log).
+// Çağıran shared memory kilidini tutmalıdır.
+void note_schedule_change(int idx)
+{
+    g_shared_mem->schedule_log[g_shared_mem->schedule_gen % SCHEDULE_LOG_SIZE] = idx;
+    g_shared_mem->schedule_gen++;
+}
+
+// Tek bir görev kaydını wheel ile eşitler (O(1))
+static void wheel_sync_slot(int i)
+{
+    TimerWheel *w = &g_wheel;
+    ScheduleInfo *sched = &g_shared_mem->schedules[i];
+    if (!sched->in_use)
+    {
+        wheel_unlink(i);
+        w->ids[i] = 0;
+        return;
+    }
+    // Yeni eklenen veya silinip yerine başkası konan kayıt
+    if (!w->armed[i] || w->ids[i] != sched->id || w->expires[i] != sched->next_run)
+    {
+        wheel_unlink(i);
+        wheel_insert(i, sched->next_run);
+        w->ids[i] = sched->id;
+    }
+}
+
+// Shared memory'deki görev tablosunu wheel ile eşitler. Yalnızca schedule_gen değiştiğinde
+// (görev eklenip silinince) çağrılır ve yalnızca schedule_log'daki kayıtlara bakar; günlük
+// taştıysa (zamanlayıcı o arada çok sayıda değişikliği kaçırdıysa) tüm tabloyu tarar.
+// Çağıran shared memory kilidini tutmalıdır.
+static void wheel_reconcile()
+{
+    TimerWheel *w = &g_wheel;
+    unsigned int gen = g_shared_mem->schedule_gen;
+    if (gen - w->known_gen > SCHEDULE_LOG_SIZE)
+    {
+        for (int i = 0; i < g_shared_mem->schedule_high; i++)
+            wheel_sync_slot(i);
+    }
+    else
+    {
+        for (unsigned int g = w->known_gen; g != gen; g++)
+        {
+            int idx = g_shared_mem->schedule_log[g % SCHEDULE_LOG_SIZE];
+            if (idx >= 0 && idx < MAX_SCHEDULES)
+                wheel_sync_slot(idx);
+        }
+    }
+    w->known_gen = gen;
+}
+
+// Tablodaki process hâlâ çalışıyor mu? Kendi child'larımız çıkınca zombi kalır ve kill(pid, 0)
+// başarılı olur; onlara waitid(WNOWAIT) ile bakılır, durum monitor'ün wait4'üne bırakılır.
+// Exec sonucu bekleyen (pid'i henüz yazılmamış) kayıt çalışıyor sayılır.
+static int process_alive(const ProcessInfo *proc)
+{
+    if (proc->pid <= 0)
+        return 1;
+    if (proc->owner_pid == getpid())
+    {
+        siginfo_t info;
+        memset(&info, 0, sizeof(info));
+        if (waitid(P_PID, proc->pid, &info, WEXITED | WNOHANG | WNOWAIT) == -1)
+            return errno != ECHILD;
+        return info.si_pid == 0; // 0: durum değişmedi, hâlâ çalışıyor
+    }
+    return !(kill(proc->pid, 0) == -1 && errno == ESRCH);
+}
+
+// Zamanı gelen görevin çalıştırmasını *run'a yazar ve bir sonraki çalışmayı planlar.
+// Çalıştırma kaydedildiyse 1, görev artık yoksa 0 döner. Başlatmayı çağıran kilidi
+// bıraktıktan sonra yapar. Çağıran shared memory kilidini tutmalıdır.
+static int fire_schedule(int idx, time_t now, DueRun *run)
+{
+    ScheduleInfo *sched = &g_shared_mem->schedules[idx];
+
+    if (!sched->in_use || g_wheel.ids[idx] != sched->id)
+        return 0;
+
+    // Önceki çalıştırma hâlâ sürüyorsa ve politika atla diyorsa başlatma.
+    // Monitor kayıtları 2 saniyede bir toplar; çıkmış ama henüz toplanmamış çalıştırma sayılmaz.
+    int still_running = 0;
+    if (sched->skip_if_running)
+    {
+        for (int i = 0; i < g_shared_mem->process_count; i++)
+        {
+            ProcessInfo *proc = &g_shared_mem->processes[i];
+            if (proc->is_active && proc->schedule_id == sched->id && process_alive(proc))
+            {
+                still_running = 1;
+                break;
+            }
+        }
+    }
+
+    memset(run, 0, sizeof(*run));
+    run->skipped = still_running;
+    run->req.schedule_id = sched->id;
+    if (still_running)
+    {
+        sched->skip_count++;
+    }
+    else
+    {
+        // Kuyruk doluysa çağıran sayacı geri alır
+        sched->run_count++;
+        memcpy(run->req.command, sched->command, sizeof(run->req.command));
+        run->req.mode = sched->mode;
+        run->req.opts = sched->opts;
+    }
+
+    time_t next = schedule_next_after(sched, now);
+    if (next == 0)
+    {
+        // Tek seferlik görev (veya bir daha eşleşmeyen cron) tamamlandı
+        sched->in_use = 0;
+        note_schedule_change(idx);
+        g_wheel.ids[idx] = 0;
+        return 1;
+    }
+    sched->next_run = next;
+    wheel_insert(idx, next);
+    return 1;
+}
+
+// Üst seviyedeki bir slotu boşaltıp görevleri alt seviyelere yeniden dağıtır
+static void wheel_cascade(int level, int slot)
+{
+    TimerWheel *w = &g_wheel;
+    int idx = w->head[level][slot];
+    w->head[level][slot] = -1;
+
+    while (idx != -1)
+    {
+        int next = w->next[idx];
+        w->armed[idx] = 0;
+        if (w->expires[idx] <= w->now)
+        {
+            // Tam seviye sınırına denk gelen görev: wheel_insert onu now+1'e iterdi,
+            // bu tick'te işlenecek seviye-0 slotuna doğrudan bağla
+            int slot0 = (int)(w->now & (WHEEL_SLOTS - 1));
+            w->level[idx] = 0;
+            w->slot[idx] = (unsigned char)slot0;
+            w->prev[idx] = -1;
+            w->next[idx] = w->head[0][slot0];
+            if (w->next[idx] != -1)
+                w->prev[w->next[idx]] = idx;
+            w->head[0][slot0] = idx;
+            w->armed[idx] = 1;
+        }
+        else
+        {
+            wheel_insert(idx, w->expires[idx]);
+        }
+        idx = next;
+    }
+}
+
+// Wheel'i şimdiki zamana kadar saniye saniye ilerletir ve zamanı gelen görevlerin
+// indexlerini due'ya yazar (sayısını döner). Wheel instance'a özeldir, kilit gerekmez.
+// Her tick'te yalnızca tek bir seviye-0 slotu işlenir; ekleme ve çıkarma O(1).
+static int wheel_advance(time_t target, int *due)
+{
+    TimerWheel *w = &g_wheel;
+    int due_count = 0;
+
+    while (w->now < target)
+    {
+        w->now++;
+        int slot = (int)(w->now & (WHEEL_SLOTS - 1));
+
+        // Alt seviye bir tur tamamladıysa üst seviyeden görevleri indir
+        for (int level = 1; level < WHEEL_LEVELS; level++)
+        {
+            if (((w->now >> (WHEEL_BITS * (level - 1))) & (WHEEL_SLOTS - 1)) != 0)
+                break;
+            wheel_cascade(level, (int)((w->now >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1)));
+        }
+
+        int idx = w->head[0][slot];
+        w->head[0][slot] = -1;
+        while (idx != -1)
+        {
+            int next = w->next[idx];
+            w->armed[idx] = 0;
+            if (w->expires[idx] <= w->now)
+                due[due_count++] = idx; // Her görev wheel'de bir kez bulunur, MAX_SCHEDULES aşılmaz
+            else
+                wheel_insert(idx, w->expires[idx]); // Bir sonraki turda
+            idx = next;
+        }
+    }
+    return due_count;
+}
+
+// Monitor thread'inden her saniye çağrılır.
+// Zamanlayıcıyı bir instance çalıştırır (scheduler_pid). O kapanırsa ilk fark eden devralır.
+// Semafor yalnızca liderlik değişirken, görev tablosu değiştiğinde veya bir görevin
+// zamanı geldiğinde alınır; diğer instance'lar ve boş tick'ler kilitsiz geçer.
+void scheduler_tick()
+{
+    static int due[MAX_SCHEDULES];
+    static DueRun runs[MAX_SCHEDULES];
+    char buffer[256];
+    time_t now = time(NULL);
+    pid_t me = getpid();
+    int locked = 0;
+
+    pid_t leader = __atomic_load_n(&g_shared_mem->scheduler_pid, __ATOMIC_RELAXED);
+    if (leader != me)
+    {
+        if (leader > 0 && !(kill(leader, 0) == -1 && errno == ESRCH))
+        {
+            // Zamanlayıcı başka bir instance'ta çalışıyor
+            g_wheel.active = 0;
+            return;
+        }
+
+        lock_shared();
+        locked = 1;
+        leader = g_shared_mem->scheduler_pid; // Kilit beklerken başkası devralmış olabilir
+        if (leader != me && leader > 0 && !(kill(leader, 0) == -1 && errno == ESRCH))
+        {
+            g_wheel.active = 0;
+            unlock_shared();
+            return;
+        }
+
+        // Liderlik boşta: devral ve wheel'i görev tablosundan yeniden kur
+        g_shared_mem->scheduler_pid = me;
+        memset(g_wheel.head, -1, sizeof(g_wheel.head));
+        memset(g_wheel.armed, 0, sizeof(g_wheel.armed));
+        memset(g_wheel.ids, 0, sizeof(g_wheel.ids));
+        g_wheel.now = now - 1;
+        g_wheel.known_gen = g_shared_mem->schedule_gen - SCHEDULE_LOG_SIZE - 1; // Tam tarama
+        g_wheel.active = 1;
+    }
+
+    if (g_wheel.known_gen != __atomic_load_n(&g_shared_mem->schedule_gen, __ATOMIC_RELAXED))
+    {
+        if (!locked)
+        {
+            lock_shared();
+            locked = 1;
+        }
+        wheel_reconcile();
+    }
+
+    int due_count = wheel_advance(now, due);
+    int run_count = 0;
+    if (due_count > 0)
+    {
+        if (!locked)
+        {
+            lock_shared();
+            locked = 1;
+        }
+        for (int i = 0; i < due_count; i++)
+            run_count += fire_schedule(due[i], now, &runs[run_count]);
+    }
+
+    if (locked)
+        unlock_shared();
+
+    // Başlatmalar ve bildirimler kilit dışında
+    int failed = 0;
+    for (int i = 0; i < run_count; i++)
+    {
+        SpawnRequest *req = &runs[i].req;
+        if (runs[i].skipped)
+        {
+            snprintf(buffer, sizeof(buffer), "[SCHEDULE] Görev #%u atlandı (önceki çalıştırma sürüyor)",
+                     req->schedule_id);
+            post_notice(NOTICE_SCHEDULE, getpid(), buffer);
+        }
+        else if (submit_spawn(req->command, req->mode, &req->opts, req->schedule_id) == -1)
+        {
+            snprintf(buffer, sizeof(buffer), "[SCHEDULE] Görev #%u atlandı (başlatma kuyruğu dolu)",
+                     req->schedule_id);
+            post_notice(NOTICE_SCHEDULE, getpid(), buffer);
+            runs[failed++].req.schedule_id = req->schedule_id; // Sayaç düzeltmesi için
+        }
+    }
+
+    // Kuyruğa giremeyen çalıştırmaları sayaçlarda atlanmış olarak işaretle (nadir)
+    if (failed > 0)
+    {
+        lock_shared();
+        for (int i = 0; i < failed; i++)
+        {
+            for (int j = 0; j < g_shared_mem->schedule_high; j++)
+            {
+                ScheduleInfo *sched = &g_shared_mem->schedules[j];
+                if (sched->in_use && sched->id == runs[i].req.schedule_id)
+                {
+                    sched->run_count--;
+                    sched->skip_count++;
+                    break;
+                }
+            }
+        }
+        unlock_shared();
+    }
+}
+
+// Görev ekler: [--in SEC | --at HH:MM | --every SEC | --cron "EXPR"] [--skip-if-running]
+//              [--detached] [başlatma seçenekleri] [--] <komut...>
+// Shared memory'ye yazar; zamanlayıcı instance'ı bir sonraki tick'te görür.
+// Görevler her zaman Detached başlatılır: o an lider olan instance'ın kapanması onları
+// öldürmemeli (--detached eski script'ler için kabul edilir).
+// Eklenen görevin ID'sini, hatada 0 döner.
+unsigned int schedule_add(int argc, char *argv[])
+{
+    ScheduleInfo sched;
+    memset(&sched, 0, sizeof(sched));
+    sched.kind = -1;
+    sched.mode = MODE_DETACHED;
+    time_t now = time(NULL);
+
+    int i = 0;
+    for (; i < argc; i++)
+    {
+        const char *opt = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        long num;
+
+        if (strcmp(opt, "--skip-if-running") == 0)
+        {
+            sched.skip_if_running = 1;
+            continue;
+        }
+        if (strcmp(opt, "--detached") == 0)
+        {
+            continue; // Zaten varsayılan
+        }
+
+        if (strcmp(opt, "--in") == 0 && val != NULL && parse_ranged_int(val, 0, 1L << 30, &num) == 0)
+        {
+            sched.kind = SCHED_ONESHOT;
+            sched.next_run = now + num;
+        }
+        else if (strcmp(opt, "--at") == 0 && val != NULL)
+        {
+            int hour, minute;
+            char extra;
+            if (sscanf(val, "%d:%d%c", &hour, &minute, &extra) != 2 ||
+                hour < 0 || hour > 23 || minute < 0 || minute > 59)
+            {
+                fprintf(stderr, "[HATA] --at HH:MM biçiminde olmalı.\n");
+                return 0;
+            }
+            // Bir sonraki HH:MM (bugün geçtiyse yarın)
+            struct tm tm;
+            localtime_r(&now, &tm);
+            tm.tm_hour = hour;
+            tm.tm_min = minute;
+            tm.tm_sec = 0;
+            tm.tm_isdst = -1;
+            time_t at = mktime(&tm);
+            if (at <= now)
+            {
+                tm.tm_mday++;
+                tm.tm_isdst = -1;
+                at = mktime(&tm);
+            }
+            sched.kind = SCHED_ONESHOT;
+            sched.next_run = at;
+        }
+        else if (strcmp(opt, "--every") == 0 && val != NULL && parse_ranged_int(val, 1, 1L << 30, &num) == 0)
+        {
+            sched.kind = SCHED_FIXED_RATE;
+            sched.interval_sec = num;
+            sched.next_run = now + num;
+        }
+        else if (strcmp(opt, "--cron") == 0 && val != NULL)
+        {
+            if (parse_cron(val, &sched.cron) == -1)
+            {
+                fprintf(stderr, "[HATA] Geçersiz cron ifadesi: %s (dakika saat gün ay haftanın_günü)\n", val);
+                return 0;
+            }
+            sched.kind = SCHED_CRON;
+            strncpy(sched.cron_expr, val, sizeof(sched.cron_expr) - 1);
+            sched.next_run = next_cron_time(&sched.cron, now);
+            if (sched.next_run == 0)
+            {
+                fprintf(stderr, "[HATA] Cron ifadesi hiçbir zaman eşleşmiyor: %s\n", val);
+                return 0;
+            }
+        }
+        else
+        {
+            break; // Zamanlama seçeneği değil, başlatma seçeneklerine geç
+        }
+        i++; // Değeri atla
+    }
+
+    if ((int)sched.kind == -1)
+    {
+        fprintf(stderr, "[HATA] --in, --at, --every veya --cron gerekli.\n");
+        return 0;
+    }
+
+    int cmd_idx = parse_launch_options(argc - i, argv + i, &sched.opts);
+    if (cmd_idx < 0)
+        return 0;
+    cmd_idx += i;
+
+    // Komutu birleştir
+    size_t len = 0;
+    for (int j = cmd_idx; j < argc; j++)
+    {
+        size_t arg_len = strlen(argv[j]);
+        if (len + arg_len + 2 > sizeof(sched.command))
+        {
+            fprintf(stderr, "[HATA] Komut çok uzun (maksimum %zu karakter).\n", sizeof(sched.command) - 1);
+            return 0;
+        }
+        if (len > 0)
+            sched.command[len++] = ' ';
+        memcpy(sched.command + len, argv[j], arg_len + 1);
+        len += arg_len;
+    }
+    if (len == 0)
+    {
+        fprintf(stderr, "[HATA] Çalıştırılacak komut verilmedi.\n");
+        return 0;
+    }
+
+    lock_shared();
+    int slot = -1;
+    for (int j = 0; j < MAX_SCHEDULES; j++)
+    {
+        if (!g_shared_mem->schedules[j].in_use)
+        {
+            slot = j;
+            break;
+        }
+    }
+    if (slot == -1)
+    {
+        unlock_shared();
+        fprintf(stderr, "[HATA] Görev tablosu dolu (Maksimum %d).\n", MAX_SCHEDULES);
+        return 0;
+    }
+
+    if (++g_shared_mem->next_schedule_id == 0)
+        g_shared_mem->next_schedule_id = 1;
+    sched.id = g_shared_mem->next_schedule_id;
+    sched.in_use = 1;
+    sched.creator_pid = getpid();
+    g_shared_mem->schedules[slot] = sched;
+    if (slot >= g_shared_mem->schedule_high)
+        g_shared_mem->schedule_high = slot + 1;
+    note_schedule_change(slot);
+    unlock_shared();
+
+    return sched.id;
+}
+
+// Görevi siler. Bulunamazsa -1 döner.
+int schedule_remove(unsigned int id)
+{
+    int found = -1;
+    lock_shared();
+    for (int i = 0; i < g_shared_mem->schedule_high; i++)
+    {
+        ScheduleInfo *sched = &g_shared_mem->schedules[i];
+        if (sched->in_use && sched->id == id)
+        {
+            sched->in_use = 0;
+            note_schedule_change(i);
+            found = 0;
+            break;
+        }
+    }
+    unlock_shared();
+    return found;
+}
+
+// Zamanlanmış görevleri listeleme fonksiyonu
+void print_schedules(SharedData *data)
+{
+    pthread_mutex_lock(&g_ui_mutex);
+    time_t now = time(NULL);
+    char when_str[80];
+    char next_str[16];
+
+    printf("╔══════╤══════════════════════╤══════════╤════════╤════════╤═════════════════╗\n");
+    printf("║ %-4s │ %-20s │ %-8s │ %-6s │ %-6s │ %-15s ║\n",
+           "ID", "Zaman", "Sonraki", "Çalış.", "Atlan.", "Command");
+    printf("╠══════╪══════════════════════╪══════════╪════════╪════════╪═════════════════╣\n");
+
+    for (int i = 0; i < data->schedule_high; i++)
+    {
+        ScheduleInfo *sched = &data->schedules[i];
+        if (!sched->in_use)
+            continue;
+
+        if (sched->kind == SCHED_FIXED_RATE)
+            snprintf(when_str, sizeof(when_str), "every %lds%s", sched->interval_sec,
+                     sched->skip_if_running ? " (skip)" : "");
+        else if (sched->kind == SCHED_CRON)
+            snprintf(when_str, sizeof(when_str), "cron %s", sched->cron_expr);
+        else
+            snprintf(when_str, sizeof(when_str), "once");
+
+        snprintf(next_str, sizeof(next_str), "%lds", (long)(sched->next_run - now));
+
+        printf("║ %-4u │ %-20.20s │ %-8s │ %6u │ %6u │ %-15.15s ║\n",
+               sched->id, when_str, next_str, sched->run_count, sched->skip_count, sched->command);
+    }
+    printf("╚══════╧══════════════════════╧══════════╧════════╧════════╧═════════════════╝\n");
+    if (data->scheduler_pid > 0)
+        printf("Zamanlayıcı instance: PID %d\n", data->scheduler_pid);
+    else
+        printf("Zamanlayıcı instance: yok (görevler bir instance açılınca çalışır)\n");
+    pthread_mutex_unlock(&g_ui_mutex);
+}
+
+// Process'i sonlandırma fonksiyonu
+void terminate_process(pid_t target_pid)
+{
+    if (g_sem == NULL || g_shared_mem == NULL)
+    {
+        fprintf(stderr, "[HATA] Shared Memory veya Semafor başlatılmamış.\n");
+        return;
+    }
+    // Sinyal gönder
+    if (kill(target_pid, SIGTERM) == 0)
+    {
+        pthread_mutex_lock(&g_ui_mutex);
+        printf("[INFO] Process %d için sonlandırma emri (SIGTERM) verildi.\n", target_pid);
+        fflush(stdout);
+        pthread_mutex_unlock(&g_ui_mutex);
+    }
+    else
+    {
+        perror("Process sonlandırma hatası");
+    }
+}
+
+// UI Menüsü Basma Fonksiyonu
+void print_program_output()
+{
+    printf("\r\033[K"); // Satırı temizle
+    printf("╔════════════════════════════════════╗\n");
+    printf("║             ProcX v1.0             ║\n");
+    printf("║ Domain: %-26.26s ║\n", g_domain);
+    printf("╠════════════════════════════════════╣\n");
+    printf("║ 1. Yeni Program Çalıştır           ║\n");
+    printf("║ 2. Çalışan Programları Listele     ║\n");
+    printf("║ 3. Program Sonlandır               ║\n");
+    printf("║ 4. Sonlanan Programlar             ║\n");
+    printf("║ 5. Zamanlanmış Görevler            ║\n");
+    printf("║ 0. Çıkış                           ║\n");
+    printf("╚════════════════════════════════════╝\n");
+    printf("Seçiminiz: ");
+}
+
+// Çalışan processleri listeleme fonksiyonu
+void print_running_processes(SharedData *data)
+{
+    pthread_mutex_lock(&g_ui_mutex);
+    time_t now = time(NULL);
+    char duration_str[20]; // Süreyi "5s" şeklinde tutmak için geçici alan
+
+    printf("╔═══════╤═════════════════╤══════════╤════════════╤════════════╤══════════╤══════╗\n");
+    printf("║ %-5s │ %-15s │ %-8s │ %-10s │ %-10s  │ %-8s │ %-4s ║\n",
+           "PID", "Command", "Mode", "Status", "Süre", "Profil", "Nice");
+    printf("╠═══════╪═════════════════╪══════════╪════════════╪════════════╪══════════╪══════╣\n");
+
+    for (int i = 0; i < data->process_count; i++)
+    {
+        ProcessInfo *proc = &data->processes[i];
+        if (proc->is_active)
+        {
+            long elapsed_seconds = (long)difftime(now, proc->start_time);
+
+            // Önce süreyi "5s" formatında bir metne dönüştür
+            snprintf(duration_str, sizeof(duration_str), "%lds", elapsed_seconds);
+
+            printf(
+                "║ %-5d │ %-15.15s │ %-8s │ %-10s │ %-10s │ %-8.8s │ %4d ║\n",
+                proc->pid,
+                proc->command,
+                proc->mode == MODE_ATACHED ? "Attached" : "Detached",
+                proc->status == STATUS_RUNNING    ? "Running"
+                : proc->status == STATUS_STARTING ? "Starting"
+                : proc->status == STATUS_CREATED  ? "Created"
+                                                  : "Terminated",
+                duration_str, // Artık metin olarak (bitişik) yazdırıyoruz
+                proc->launch.profile[0] != '\0' ? proc->launch.profile : "default",
+                proc->launch.nice);
+        }
+    }
+    printf("╚═══════╧═════════════════╧══════════╧════════════╧════════════╧══════════╧══════╝\n");
+
+    // Kabul kontrolü devreye girdiyse özetini göster
+    const AdmissionStats *stats = &data->admission;
+    if (stats->pressure_mask != 0 || stats->waiting > 0 || stats->deferred_total > 0 || stats->throttled_total > 0)
+    {
+        char names[32];
+        pressure_names(stats->pressure_mask, names, sizeof(names));
+        printf("Baskı: %s | Bekleyen: %d | Ertelenen: %u | Kısılan: %u | Sonradan başlatılan: %u | Düşürülen: %u\n",
+               names[0] != '\0' ? names : "yok", stats->waiting, stats->deferred_total,
+               stats->throttled_total, stats->resumed_total, stats->dropped_total);
+    }
+    pthread_mutex_unlock(&g_ui_mutex);
+}
+
+// Sonlanan process geçmişini (en yeni en üstte) listeleme fonksiyonu
+void print_exit_history(SharedData *data)
+{
+    pthread_mutex_lock(&g_ui_mutex);
+    char result_str[20];
+
+    printf("╔═══════╤═════════════════╤══════════════╤══════════╤══════════╤══════════╗\n");
+    printf("║ %-5s │ %-15s │ %-13s │ %-8s │ %-8s │ %-8s ║\n",
+           "PID", "Command", "Sonuç", "User", "Sys", "Max RSS");
+    printf("╠═══════╪═════════════════╪══════════════╪══════════╪══════════╪══════════╣\n");
+
+    unsigned int count = data->history_total < MAX_HISTORY ? data->history_total : MAX_HISTORY;
+    for (unsigned int n = 1; n <= count; n++)
+    {
+        ExitRecord *rec = &data->history[(data->history_total - n) % MAX_HISTORY];
+
+        if (!rec->status_known)
+            snprintf(result_str, sizeof(result_str), "Unknown");
+        else if (rec->term_signal != 0)
+            snprintf(result_str, sizeof(result_str), "Signal %d", rec->term_signal);
+        else
+            snprintf(result_str, sizeof(result_str), "Exit %d", rec->exit_code);
+
+        printf("║ %-5d │ %-15.15s │ %-12s │ %6ldms │ %6ldms │ %6ldKB ║\n",
+               rec->pid,
+               rec->command,
+               result_str,
+               rec->user_time_ms,
+               rec->sys_time_ms,
+               rec->max_rss_kb);
+    }
+    printf("╚═══════╧═════════════════╧══════════════╧══════════╧══════════╧══════════╝\n");
+    pthread_mutex_unlock(&g_ui_mutex);
+}
+
+// --- BİLDİRİM BİRLEŞTİRME ---
+
+// a anına kaç ms kaldığını döner (geçtiyse negatif)
+static long notice_ms_until(const struct timespec *a, const struct timespec *now)
+{
+    return (a->tv_sec - now->tv_sec) * 1000L + (a->tv_nsec - now->tv_nsec) / 1000000L;
+}
+
+static void notice_add_ms(struct timespec *t, long ms)
+{
+    t->tv_sec += ms / 1000;
+    t->tv_nsec += (ms % 1000) * 1000000L;
+    if (t->tv_nsec >= 1000000000L)
+    {
+        t->tv_sec++;
+        t->tv_nsec -= 1000000000L;
+    }
+}
+
+// PROCX_NOTICES ortam değişkenini okur, ör. "window=500,rate=2,burst=4".
+// "off" birleştirmeyi ve hız sınırını kapatır: her olay geldiği anda ayrı satır olur.
+void init_notices()
+{
+    const char *env = getenv(NOTICE_ENV);
+    if (env != NULL && strcmp(env, "off") == 0)
+    {
+        g_notice_window_ms = 0;
+        g_notice_rate = 0;
+    }
+    else if (env != NULL)
+    {
+        char config[256];
+        strncpy(config, env, sizeof(config) - 1);
+        config[sizeof(config) - 1] = '\0';
+
+        for (char *item = strtok(config, ","); item != NULL; item = strtok(NULL, ","))
+        {
+            char *eq = strchr(item, '=');
+            long num;
+            if (eq == NULL)
+            {
+                fprintf(stderr, "[HATA] %s: geçersiz öğe '%s' (yok sayıldı)\n", NOTICE_ENV, item);
+                continue;
+            }
+            *eq = '\0';
+
+            if (strcmp(item, "window") == 0 && parse_ranged_int(eq + 1, 0, 10000, &num) == 0)
+                g_notice_window_ms = num;
+            else if (strcmp(item, "rate") == 0 && parse_ranged_int(eq + 1, 0, 1000, &num) == 0)
+                g_notice_rate = (int)num;
+            else if (strcmp(item, "burst") == 0 && parse_ranged_int(eq + 1, 1, NOTICE_BUCKETS, &num) == 0)
+                g_notice_burst = (int)num;
+            else
+                fprintf(stderr, "[HATA] %s: geçersiz öğe '%s=%s' (yok sayıldı)\n", NOTICE_ENV, item, eq + 1);
+        }
+    }
+
+    g_notice_tokens = g_notice_burst;
+    clock_gettime(CLOCK_MONOTONIC, &g_notice_refill);
+}
+
+// Bildirimi bekleyenlere ekler. Aynı pencerede aynı (tür, sahip) için gelen olaylar
+// tek satırda toplanır; basma işini event loop yapar, bu yüzden çağıran (shared memory
+// kilidini tutuyor olsa bile) UI mutex'ini hiç beklemez.
+void post_notice(NoticeKind kind, pid_t owner_pid, const char *message)
+{
+    pthread_mutex_lock(&g_notice_mutex);
+    int was_empty = (g_notice_count == 0 && g_notice_overflow_total == 0);
+
+    int idx;
+    for (idx = 0; idx < g_notice_count; idx++)
+    {
+        if (g_notices[idx].kind == kind && g_notices[idx].owner_pid == owner_pid)
+            break;
+    }
+    if (idx < g_notice_count)
+    {
+        g_notices[idx].count++;
+    }
+    else if (g_notice_count < NOTICE_BUCKETS)
+    {
+        NoticeBucket *bucket = &g_notices[g_notice_count++];
+        bucket->kind = kind;
+        bucket->owner_pid = owner_pid;
+        bucket->count = 1;
+        snprintf(bucket->first, sizeof(bucket->first), "%s", message);
+    }
+    else
+    {
+        g_notice_overflow[kind]++; // Gruplar dolu: türüne göre sayılır
+        g_notice_overflow_total++;
+    }
+
+    if (was_empty)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &g_notice_deadline);
+        notice_add_ms(&g_notice_deadline, g_notice_window_ms);
+    }
+    pthread_mutex_unlock(&g_notice_mutex);
+
+    // Event loop poll zaman aşımını yeni son tarihe göre ayarlasın
+    if ((was_empty || g_notice_window_ms == 0) && g_wake_pipe[1] != -1)
+    {
+        char c = 1;
+        write(g_wake_pipe[1], &c, 1);
+    }
+}
+
+// Bekleyen bildirimlerin basılmasına kaç ms kaldığını döner (-1: bekleyen yok).
+// Event loop bunu poll zaman aşımı olarak kullanır.
+int notice_timeout_ms()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&g_notice_mutex);
+    int timeout = -1;
+    if (g_notice_count > 0 || g_notice_overflow_total > 0)
+    {
+        long left = notice_ms_until(&g_notice_deadline, &now) + 1; // Aşağı yuvarlamayı telafi et
+        timeout = left < 0 ? 0 : (int)left;
+    }
+    pthread_mutex_unlock(&g_notice_mutex);
+    return timeout;
+}
+
+// Süresi dolan bildirimleri basar. Her grup tek satırdır ve bir satır hakkı harcar;
+// hakkı kalmayan gruplar bekletilir ve birikmeye devam eder. Böylece churn ne kadar
+// yüksek olursa olsun pencere başına en fazla burst + NOTICE_KINDS satır basılır.
+void flush_notices()
+{
+    static const char *const summary_fmt[NOTICE_KINDS] = {
+        "[MONITOR] %d process sonlandı (owner %d)",
+        "[IPC] %d process sonlandırıldı (owner %d)",
+        "[IPC] %d yeni process başlatıldı (owner %d)",
+        "[IPC] %d process hazır (owner %d)",
+        "[READY] %d process hazır (owner %d)",
+        "[SUCCESS] %d process başlatıldı (owner %d)",
+        "[HATA] %d başlatma başarısız (owner %d)",
+        "[SCHEDULE] %d görev çalıştırması atlandı (owner %d)",
+        "[PSI] %d kabul kontrolü olayı (owner %d, ayrıntı: procx pressure)",
+        "[UYARI] %d process READY=1 göndermeden Running sayıldı (owner %d)",
+    };
+    static const char *const overflow_fmt[NOTICE_KINDS] = {
+        "[MONITOR] %d process daha sonlandı (diğer owner'lar)",
+        "[IPC] %d process daha sonlandırıldı (diğer owner'lar)",
+        "[IPC] %d process daha başlatıldı (diğer owner'lar)",
+        "[IPC] %d process daha hazır (diğer owner'lar)",
+        "[READY] %d process daha hazır",
+        "[SUCCESS] %d process daha başlatıldı",
+        "[HATA] %d başlatma daha başarısız",
+        "[SCHEDULE] %d görev çalıştırması daha atlandı",
+        "[PSI] %d kabul kontrolü olayı daha",
+        "[UYARI] %d process daha READY=1 göndermeden Running sayıldı",
+    };
+    char lines[NOTICE_BUCKETS + NOTICE_KINDS][256];
+    int line_count = 0;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&g_notice_mutex);
+    if ((g_notice_count == 0 && g_notice_overflow_total == 0) || notice_ms_until(&g_notice_deadline, &now) > 0)
+    {
+        pthread_mutex_unlock(&g_notice_mutex);
+        return;
+    }
+
+    // Satır haklarını geçen süreye göre yenile
+    if (g_notice_rate > 0)
+    {
+        double elapsed = (now.tv_sec - g_notice_refill.tv_sec) +
+                         (now.tv_nsec - g_notice_refill.tv_nsec) / 1e9;
+        g_notice_tokens += elapsed * g_notice_rate;
+        if (g_notice_tokens > g_notice_burst)
+            g_notice_tokens = g_notice_burst;
+    }
+    g_notice_refill = now;
+
+    int kept = 0;
+    for (int i = 0; i < g_notice_count; i++)
+    {
+        NoticeBucket *bucket = &g_notices[i];
+        if (line_count >= g_notice_burst || (g_notice_rate > 0 && g_notice_tokens < 1))
+        {
+            g_notices[kept++] = *bucket; // Sonraki pencerede basılır
+            continue;
+        }
+        if (bucket->count == 1)
+            snprintf(lines[line_count], sizeof(lines[0]), "%s", bucket->first);
+        else
+            snprintf(lines[line_count], sizeof(lines[0]), summary_fmt[bucket->kind],
+                     bucket->count, bucket->owner_pid);
+        line_count++;
+        if (g_notice_rate > 0)
+            g_notice_tokens -= 1;
+    }
+    g_notice_count = kept;
+
+    // Gruplara sığmayanlar tür başına tek satır (hak harcamaz, en fazla NOTICE_KINDS satır)
+    for (int k = 0; k < NOTICE_KINDS; k++)
+    {
+        if (g_notice_overflow[k] > 0)
+            snprintf(lines[line_count++], sizeof(lines[0]), overflow_fmt[k], g_notice_overflow[k]);
+        g_notice_overflow[k] = 0;
+    }
+    g_notice_overflow_total = 0;
+
+    if (kept > 0)
+    {
+        // Hak yenilenene kadar (en az bir pencere) bekle
+        long wait_ms = g_notice_window_ms;
+        if (g_notice_rate > 0 && g_notice_tokens < 1)
+        {
+            long refill_ms = (long)((1 - g_notice_tokens) * 1000 / g_notice_rate) + 1;
+            if (refill_ms > wait_ms)
+                wait_ms = refill_ms;
+        }
+        g_notice_deadline = now;
+        notice_add_ms(&g_notice_deadline, wait_ms);
+    }
+    pthread_mutex_unlock(&g_notice_mutex);
+
+    if (line_count == 0)
+        return;
+
+    // Tüm satırlar tek seferde: UI mutex'i ve stdout pencere başına bir kez meşgul olur
+    pthread_mutex_lock(&g_ui_mutex);
+    printf("\r\033[K");
+    for (int i = 0; i < line_count; i++)
+        printf(">>> %s\n", lines[i]);
+    printf("Seçiminiz: ");
+    fflush(stdout);
+    pthread_mutex_unlock(&g_ui_mutex);
+}
+
+void signal_handler(int signum)
+{
+    int saved_errno = errno;
+    if (signum == SIGCHLD)
+    {
+        // Child process sonlandığında yapılacak işlemler
+        // Burada herhangi bir işlem yapmıyoruz, monitor thread süreci kontrol edecek
+        // İlgili child process'i waitpid ile toplamak monitor thread'in işi
+        // Eğer burada waitpid çağırırsak monitor thread ile çakışabiliriz
+    }
+    else if (signum == SIGINT || signum == SIGTERM)
+    {
+        g_shutdown = 1;
+    }
+    errno = saved_errno;
+}
+
+// JSON çıktısı için string'i tırnaklarıyla ve kaçış karakterleriyle basar
+void print_json_string(const char *str)
+{
+    putchar('"');
+    for (const unsigned char *c = (const unsigned char *)str; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            printf("\\%c", *c);
+        }
+        else if (*c < 0x20)
+        {
+            printf("\\u%04x", *c);
+        }
+        else
+        {
+            putchar(*c);
+        }
+    }
+    putchar('"');
+}
+
+// Kabul kontrolü sayaçlarını JSON nesnesi olarak basar
+static void print_admission_json(const AdmissionStats *stats)
+{
+    char names[32];
+    pressure_names(stats->pressure_mask, names, sizeof(names));
+    printf("{\"pressure\":");
+    print_json_string(names);
+    printf(",\"waiting\":%d,\"deferred\":%u,\"throttled\":%u,\"resumed\":%u,\"dropped\":%u,\"last_pressure\":%ld}",
+           stats->waiting, stats->deferred_total, stats->throttled_total, stats->resumed_total,
+           stats->dropped_total, (long)stats->last_pressure);
+}
+
+// Process durumunun JSON çıktısındaki karşılığı
+static const char *status_name(ProcessStatus status)
+{
+    switch (status)
+    {
+    case STATUS_RUNNING:
+        return "running";
+    case STATUS_TERMINATED:
+        return "terminated";
+    case STATUS_CREATED:
+        return "created";
+    case STATUS_STARTING:
+        return "starting";
+    }
+    return "unknown";
+}
+
+// Snapshot içinde PID'ye ait aktif process kaydını bulur
+static const ProcessInfo *find_process(const SharedData *data, pid_t pid)
+{
+    for (int i = 0; i < data->process_count && i < MAX_PROCESSES; i++)
+    {
+        if (data->processes[i].is_active && data->processes[i].pid == pid)
+        {
+            return &data->processes[i];
+        }
+    }
+    return NULL;
+}
+
+// Salt-okunur segmentten snapshot alır (görev tablosu yalnızca with_schedules ile).
+// Segment yoksa boş tablo döner. Snapshot alınamazsa -1 döner.
+static int take_snapshot(SharedData *snapshot, int with_schedules)
+{
+    const SharedData *data = g_shared_mem;
+    if (data == NULL)
+    {
+        data = attach_shared_readonly();
+    }
+    if (data == NULL)
+    {
+        memset(snapshot, 0, SNAPSHOT_CORE); // schedule_high 0: görev tablosu okunmaz
+        return 0;
+    }
+    if (snapshot_shared(data, snapshot, with_schedules) == -1)
+    {
+        fprintf(stderr, "[HATA] Shared memory'den tutarlı bir kopya alınamadı.\n");
+        return -1;
+    }
+    return 0;
+}
+
+// procx ls [--json]
+static int cli_list(int json)
+{
+    static SharedData snapshot; // Stack'i şişirmemek için statik
+    if (take_snapshot(&snapshot, 0) == -1)
+    {
+        return 1;
+    }
+
+    if (!json)
+    {
+        print_running_processes(&snapshot);
+        return 0;
+    }
+
+    time_t now = time(NULL);
+    printf("{\"instances\":%d,\"admission\":", snapshot.instance_count);
+    print_admission_json(&snapshot.admission);
+    printf(",\"processes\":[");
+    int first = 1;
+    for (int i = 0; i < snapshot.process_count && i < MAX_PROCESSES; i++)
+    {
+        const ProcessInfo *proc = &snapshot.processes[i];
+        if (!proc->is_active)
+            continue;
+
+        printf("%s{\"pid\":%d,\"owner_pid\":%d,\"command\":", first ? "" : ",", proc->pid, proc->owner_pid);
+        print_json_string(proc->command);
+        printf(",\"mode\":\"%s\",\"status\":\"%s\",\"start_time\":%ld,\"elapsed\":%ld,\"pty\":%s,",
+               proc->mode == MODE_ATACHED ? "attached" : "detached",
+               status_name(proc->status),
+               (long)proc->start_time,
+               (long)(now - proc->start_time),
+               proc->launch.use_pty ? "true" : "false");
+        if (proc->ready_latency_ms >= 0)
+            printf("\"ready_ms\":%ld,", proc->ready_latency_ms);
+        else
+            printf("\"ready_ms\":null,");
+        printf("\"limits\":{\"profile\":");
+        print_json_string(proc->launch.profile[0] != '\0' ? proc->launch.profile : "default");
+        printf(",\"nice\":%d,\"ioprio_class\":\"%s\",\"ioprio_level\":%d,\"oom_score_adj\":%d,"
+               "\"mem_mb\":%ld,\"nofile\":%ld,\"cpu_sec\":%ld}}",
+               proc->launch.nice,
+               ioprio_class_name(proc->launch.ioprio_class),
+               proc->launch.ioprio_level,
+               proc->launch.oom_score_adj,
+               proc->launch.mem_limit_mb,
+               proc->launch.nofile_limit,
+               proc->launch.cpu_limit_sec);
+        first = 0;
+    }
+    printf("]}\n");
+    return 0;
+}
+
+// --- CANLI GÖRÜNÜM (procx top) ---
+
+// Süreyi "45s", "12m05s", "3h20m", "2d04h" biçiminde yazar
+static void format_duration(long seconds, char *buf, size_t size)
+{
+    if (seconds < 0)
+        seconds = 0;
+    if (seconds < 60)
+        snprintf(buf, size, "%lds", seconds);
+    else if (seconds < 3600)
+        snprintf(buf, size, "%ldm%02lds", seconds / 60, seconds % 60);
+    else if (seconds < 86400)
+        snprintf(buf, size, "%ldh%02ldm", seconds / 3600, (seconds % 3600) / 60);
+    else
+        snprintf(buf, size, "%ldd%02ldh", seconds / 86400, (seconds % 86400) / 3600);
+}
+
+// qsort karşılaştırıcısı (sıralama anahtarı g_top_sort'ta)
+static int compare_top_rows(const void *a, const void *b)
+{
+    const ProcessInfo *pa = *(const ProcessInfo *const *)a;
+    const ProcessInfo *pb = *(const ProcessInfo *const *)b;
+    long diff = 0;
+
+    switch (g_top_sort)
+    {
+    case TOP_SORT_RUNTIME:
+        diff = (long)pa->start_time - (long)pb->start_time; // En uzun çalışan önce
+        break;
+    case TOP_SORT_OWNER:
+        diff = (long)pa->owner_pid - (long)pb->owner_pid;
+        break;
+    case TOP_SORT_MODE:
+        diff = (long)pa->mode - (long)pb->mode;
+        break;
+    case TOP_SORT_PID:
+        break;
+    }
+    if (diff == 0)
+        diff = (long)pa->pid - (long)pb->pid;
+    return (diff > 0) - (diff < 0);
+}
+
+// Process filtreye uyuyor mu: komutta geçiyorsa veya PID/owner PID'ye eşitse
+static int top_matches(const ProcessInfo *proc, const char *filter)
+{
+    char num[16];
+    if (filter[0] == '\0' || strstr(proc->command, filter) != NULL)
+        return 1;
+    snprintf(num, sizeof(num), "%d", proc->pid);
+    if (strcmp(num, filter) == 0)
+        return 1;
+    snprintf(num, sizeof(num), "%d", proc->owner_pid);
+    return strcmp(num, filter) == 0;
+}
+
+// Çıktı tamponuna ekler (taşarsa keser; kare yine tek write ile gider)
+static void top_append(TopFrame *frame, const char *data, size_t len)
+{
+    if (len > sizeof(frame->out) - frame->out_len)
+        len = sizeof(frame->out) - frame->out_len;
+    memcpy(frame->out + frame->out_len, data, len);
+    frame->out_len += len;
+}
+
+// s'nin en fazla max baytlık, UTF-8 karakter ortasında bitmeyen önekinin uzunluğu
+static size_t utf8_prefix_len(const char *s, size_t max)
+{
+    size_t len = strlen(s);
+    if (len <= max)
+        return len;
+    while (max > 0 && ((unsigned char)s[max] & 0xc0) == 0x80)
+        max--; // Devam baytında kesme, karakterin başına geri çekil
+    return max;
+}
+
+// Satır y'nin [from, to) sütunlarını imleci oraya taşıyarak tampona ekler (1 tabanlı ANSI)
+static void top_emit(TopFrame *frame, int y, int from, int to)
+{
+    char move[32];
+    int n = snprintf(move, sizeof(move), "\033[%d;%dH", y + 1, from + 1);
+    top_append(frame, move, n);
+    top_append(frame, frame->cur[y] + from, to - from);
+}
+
+// Bir kareyi çizer. Tablo satırları hücre hücre karşılaştırılır, yalnızca değişen
+// hücreler yazılır; başlık ve alt satır değiştiyse bütün olarak yazılır.
+// Kare tek bir write() ile terminale gider.
+static void top_render(const SharedData *snapshot, TopView *view, TopFrame *frame)
+{
+    // Tablo satırlarındaki hücrelerin başlangıç sütunları (PID, OWNER, MODE, STATUS, RUNTIME, PROFILE, NICE, COMMAND)
+    static const int cells[] = {0, 7, 14, 23, 34, 44, 53, 59};
+    const int cell_count = sizeof(cells) / sizeof(cells[0]);
+    const ProcessInfo *rows[MAX_PROCESSES];
+    int total = 0;
+    int shown = 0;
+    time_t now = time(NULL);
+
+    for (int i = 0; i < snapshot->process_count && i < MAX_PROCESSES; i++)
+    {
+        const ProcessInfo *proc = &snapshot->processes[i];
+        if (!proc->is_active)
+            continue;
+        total++;
+        if (top_matches(proc, view->filter))
+            rows[shown++] = proc;
+    }
+    g_top_sort = view->sort;
+    qsort(rows, shown, sizeof(rows[0]), compare_top_rows);
+
+    int page_size = view->height - 3 > 0 ? view->height - 3 : 1; // Başlık, sütun adları, alt satır
+    int pages = shown > 0 ? (shown + page_size - 1) / page_size : 1;
+    if (view->page >= pages)
+        view->page = pages - 1;
+    if (view->page < 0)
+        view->page = 0;
+
+    // Satırları hazırla (ekran genişliğine boşlukla doldurulur)
+    char line[TOP_MAX_COLS * 2];
+    char duration[16];
+    int width = view->width;
+    for (int y = 0; y < view->height; y++)
+    {
+        if (y == 0)
+        {
+            snprintf(line, sizeof(line), "ProcX top | domain: %s | %d/%d process | sıralama: %s%s | filtre: %s | sayfa %d/%d | %.1fs",
+                     g_domain, shown, total, g_top_sort_names[view->sort], view->reverse ? " (ters)" : "",
+                     view->filter[0] != '\0' ? view->filter : "-", view->page + 1, pages, view->interval_ms / 1000.0);
+        }
+        else if (y == 1)
+        {
+            snprintf(line, sizeof(line), "%-6s %-6s %-8s %-10s %9s %-8s %4s  %s",
+                     "PID", "OWNER", "MODE", "STATUS", "RUNTIME", "PROFILE", "NICE", "COMMAND");
+        }
+        else if (y == view->height - 1)
+        {
+            if (view->editing)
+                snprintf(line, sizeof(line), "Filtre: %s_   (Enter: uygula, Esc: iptal)", view->edit_buf);
+            else
+                snprintf(line, sizeof(line), "q: çıkış  s: sıralama  r: ters  /: filtre  n/p: sayfa  +/-: hız");
+        }
+        else
+        {
+            int index = view->page * page_size + (y - 2);
+            if (view->reverse)
+                index = shown - 1 - index;
+            if (index < 0 || index >= shown || y - 2 >= page_size)
+            {
+                line[0] = '\0';
+            }
+            else
+            {
+                const ProcessInfo *proc = rows[index];
+                format_duration((long)(now - proc->start_time), duration, sizeof(duration));
+                snprintf(line, sizeof(line), "%-6d %-6d %-8s %-10s %9s %-8.8s %4d  %s",
+                         proc->pid, proc->owner_pid,
+                         proc->mode == MODE_ATACHED ? "attached" : "detached",
+                         status_name(proc->status), duration,
+                         proc->launch.profile[0] != '\0' ? proc->launch.profile : "default",
+                         proc->launch.nice, proc->command);
+                // Hücre sütunları bayt sayısına eşit olsun diye komuttaki ASCII dışı baytları değiştir
+                for (char *c = line; *c != '\0'; c++)
+                {
+                    if ((unsigned char)*c < 0x20 || (unsigned char)*c >= 0x7f)
+                        *c = '?';
+                }
+            }
+        }
+
+        // Genişliğe göre kes veya boşlukla doldur. Başlık/alt satır UTF-8 içerebilir:
+        // karakter sınırında kesilir, hücrelere bölünmeden bütün yazıldığı için de
+        // ekranda kısa kalan kısım \033[K ile temizlenir.
+        size_t len = utf8_prefix_len(line, width);
+        memcpy(frame->cur[y], line, len);
+        memset(frame->cur[y] + len, ' ', width - len);
+        frame->cur[y][width] = '\0';
+    }
+
+    // Farkları tampona yaz
+    frame->out_len = 0;
+    if (!view->is_tty)
+    {
+        // Terminal değil (ör. pipe): kareyi düz metin olarak bas
+        for (int y = 0; y < view->height; y++)
+        {
+            size_t len = width;
+            while (len > 0 && frame->cur[y][len - 1] == ' ')
+                len--;
+            if (len == 0)
+                continue; // Boş tablo satırları
+            top_append(frame, frame->cur[y], len);
+            top_append(frame, "\n", 1);
+        }
+    }
+    else
+    {
+        if (frame->full_redraw)
+            top_append(frame, "\033[H\033[2J", 7);
+        for (int y = 0; y < view->height; y++)
+        {
+            int table_row = (y >= 2 && y < view->height - 1);
+            if (frame->full_redraw || !table_row)
+            {
+                if (frame->full_redraw || strcmp(frame->cur[y], frame->prev[y]) != 0)
+                {
+                    top_emit(frame, y, 0, width);
+                    top_append(frame, "\033[K", 3); // UTF-8 satır ekranda daha kısa kalabilir
+                }
+                continue;
+            }
+            for (int c = 0; c < cell_count && cells[c] < width; c++)
+            {
+                int from = cells[c];
+                int to = (c + 1 < cell_count && cells[c + 1] < width) ? cells[c + 1] : width;
+                if (memcmp(frame->cur[y] + from, frame->prev[y] + from, to - from) != 0)
+                    top_emit(frame, y, from, to);
+            }
+        }
+        memcpy(frame->prev, frame->cur, sizeof(frame->prev));
+        frame->full_redraw = 0;
+    }
+
+    if (frame->out_len > 0)
+        write(STDOUT_FILENO, frame->out, frame->out_len);
+}
+
+// Klavyeden okunan tuşları işler. Çıkılacaksa 1 döner.
+static int top_handle_keys(TopView *view, const char *keys, ssize_t n)
+{
+    for (ssize_t i = 0; i < n; i++)
+    {
+        char key = keys[i];
+
+        if (view->editing)
+        {
+            size_t len = strlen(view->edit_buf);
+            if (key == '\r' || key == '\n')
+            {
+                strcpy(view->filter, view->edit_buf);
+                view->editing = 0;
+                view->page = 0;
+            }
+            else if (key == 0x1b)
+                view->editing = 0;
+            else if ((key == 0x7f || key == '\b') && len > 0)
+                view->edit_buf[len - 1] = '\0';
+            else if ((unsigned char)key >= 0x20 && key != 0x7f && len < sizeof(view->edit_buf) - 1)
+            {
+                view->edit_buf[len] = key;
+                view->edit_buf[len + 1] = '\0';
+            }
+            continue;
+        }
+
+        // PgUp / PgDn: ESC [ 5 ~ / ESC [ 6 ~
+        if (key == 0x1b && i + 3 < n && keys[i + 1] == '[' && keys[i + 3] == '~')
+        {
+            if (keys[i + 2] == '5')
+                view->page--;
+            else if (keys[i + 2] == '6')
+                view->page++;
+            i += 3;
+            continue;
+        }
+
+        switch (key)
+        {
+        case 'q':
+        case 'Q':
+            return 1;
+        case 's':
+            view->sort = (view->sort + 1) % (sizeof(g_top_sort_names) / sizeof(g_top_sort_names[0]));
+            view->page = 0;
+            break;
+        case 'r':
+            view->reverse = !view->reverse;
+            break;
+        case 'n':
+        case ' ':
+            view->page++;
+            break;
+        case 'p':
+        case 'b':
+            view->page--;
+            break;
+        case '+':
+            view->interval_ms = view->interval_ms > 200 ? view->interval_ms - 100 : 100;
+            break;
+        case '-':
+            view->interval_ms = view->interval_ms < 60000 ? view->interval_ms + 100 : 60000;
+            break;
+        case '/':
+            view->editing = 1;
+            strcpy(view->edit_buf, view->filter);
+            break;
+        }
+    }
+    return 0;
+}
+
+// procx top [--interval SEC] [--sort runtime|owner|mode|pid] [--filter TEXT] [--count N]
+// Shared memory'nin kilitsiz kopyalarından canlı tablo çizer.
+static int cli_top(int argc, char const *argv[])
+{
+    static TopFrame frame; // Stack'i şişirmemek için statik
+    static SharedData snapshot;
+    TopView view;
+    long count = 0;
+    memset(&view, 0, sizeof(view));
+    view.interval_ms = 1000;
+
+    for (int i = 0; i < argc; i++)
+    {
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (val == NULL)
+        {
+            fprintf(stderr, "[HATA] %s bir değer bekliyor.\n", argv[i]);
+            return 2;
+        }
+        if (strcmp(argv[i], "--interval") == 0)
+        {
+            char *end;
+            double sec = strtod(val, &end);
+            if (*end != '\0' || sec < 0.1 || sec > 60)
+            {
+                fprintf(stderr, "[HATA] --interval 0.1-60 saniye arasında olmalı.\n");
+                return 2;
+            }
+            view.interval_ms = (long)(sec * 1000);
+        }
+        else if (strcmp(argv[i], "--sort") == 0)
+        {
+            size_t n;
+            for (n = 0; n < sizeof(g_top_sort_names) / sizeof(g_top_sort_names[0]); n++)
+            {
+                if (strcmp(val, g_top_sort_names[n]) == 0)
+                    break;
+            }
+            if (n == sizeof(g_top_sort_names) / sizeof(g_top_sort_names[0]))
+            {
+                fprintf(stderr, "[HATA] Geçersiz sıralama: %s (runtime, owner, mode, pid)\n", val);
+                return 2;
+            }
+            view.sort = (TopSortKey)n;
+        }
+        else if (strcmp(argv[i], "--filter") == 0)
+        {
+            strncpy(view.filter, val, sizeof(view.filter) - 1);
+        }
+        else if (strcmp(argv[i], "--count") == 0)
+        {
+            if (parse_ranged_int(val, 1, 1L << 30, &count) != 0)
+            {
+                fprintf(stderr, "[HATA] --count pozitif bir sayı olmalı.\n");
+                return 2;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Kullanım: procx top [--interval SEC] [--sort runtime|owner|mode|pid] [--filter TEXT] [--count N]\n");
+            return 2;
+        }
+        i++;
+    }
+
+    // Ctrl-C ve pencere boyutu değişince poll'dan uyan
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = signal_handler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGWINCH, &sa, NULL);
+
+    view.is_tty = isatty(STDOUT_FILENO);
+    int keys_tty = isatty(STDIN_FILENO);
+    struct termios saved, raw;
+    if (keys_tty && tcgetattr(STDIN_FILENO, &saved) == 0)
+    {
+        // Satır tamponu ve yankı kapalı, Ctrl-C (ISIG) çalışmaya devam eder
+        raw = saved;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+    else
+    {
+        keys_tty = 0;
+    }
+    // --count ile son kare çıkışta ekranda kalmalı, bu yüzden alternatif ekran kullanılmaz
+    int alt_screen = (view.is_tty && count == 0);
+    if (view.is_tty)
+    {
+        const char *enter = alt_screen ? "\033[?1049h\033[?25l" : "\033[?25l"; // Alternatif ekran, imleci gizle
+        write(STDOUT_FILENO, enter, strlen(enter));
+    }
+
+    long frames = 0;
+    while (!g_shutdown)
+    {
+        // Terminal boyutu değiştiyse baştan çiz
+        struct winsize ws;
+        int height = 24, width = view.is_tty ? 80 : 160; // Pipe'ta satırı kırpmaya gerek yok
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_row > 0 && ws.ws_col > 0)
+        {
+            height = ws.ws_row;
+            width = ws.ws_col;
+        }
+        if (height > TOP_MAX_ROWS)
+            height = TOP_MAX_ROWS;
+        if (width > TOP_MAX_COLS)
+            width = TOP_MAX_COLS;
+        if (height < 4)
+            height = 4;
+        if (height != view.height || width != view.width)
+        {
+            view.height = height;
+            view.width = width;
+            frame.full_redraw = 1;
+        }
+
+        if (take_snapshot(&snapshot, 0) == -1)
+            break;
+        top_render(&snapshot, &view, &frame);
+        if (count > 0 && ++frames >= count)
+            break;
+
+        // Bir sonraki kareye kadar tuş bekle; tuş gelirse hemen yeniden çiz
+        struct pollfd pfd = {keys_tty ? STDIN_FILENO : -1, POLLIN, 0};
+        if (poll(&pfd, 1, (int)view.interval_ms) > 0 && (pfd.revents & POLLIN))
+        {
+            char keys[64];
+            ssize_t n = read(STDIN_FILENO, keys, sizeof(keys));
+            if (n > 0 && top_handle_keys(&view, keys, n))
+                break;
+        }
+    }
+
+    if (alt_screen)
+    {
+        const char *leave = "\033[?25h\033[?1049l";
+        write(STDOUT_FILENO, leave, strlen(leave));
+    }
+    else if (view.is_tty)
+    {
+        // İmleci karenin altına al ki kabuk istemi son karenin üstüne yazılmasın
+        char leave[32];
+        int n = snprintf(leave, sizeof(leave), "\033[?25h\033[%d;1H\n", view.height);
+        write(STDOUT_FILENO, leave, n);
+    }
+    if (keys_tty)
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    return 0;
+}
+
+// procx pressure [--json]
+// Anlık PSI değerlerini (/proc/pressure) ve kabul kontrolü sayaçlarını basar.
+static int cli_pressure(int json)
+{
+    static SharedData snapshot;
+    if (take_snapshot(&snapshot, 0) == -1)
+        return 1;
+
+    if (json)
+    {
+        printf("{\"avg10\":{");
+        for (int i = 0; i < PSI_RESOURCES; i++)
+        {
+            double avg10 = read_psi_avg10(g_psi[i].name);
+            printf(avg10 >= 0 ? "%s\"%s\":%.2f" : "%s\"%s\":null", i > 0 ? "," : "", g_psi[i].name, avg10);
+        }
+        printf("},\"admission\":");
+        print_admission_json(&snapshot.admission);
+        printf("}\n");
+        return 0;
+    }
+
+    for (int i = 0; i < PSI_RESOURCES; i++)
+    {
+        double avg10 = read_psi_avg10(g_psi[i].name);
+        if (avg10 >= 0)
+            printf("%-7s some avg10 %6.2f%%%s\n", g_psi[i].name, avg10,
+                   (snapshot.admission.pressure_mask & (1u << i)) ? "  (eşik aşıldı)" : "");
+        else
+            printf("%-7s PSI okunamadı\n", g_psi[i].name);
+    }
+    const AdmissionStats *stats = &snapshot.admission;
+    printf("Bekleyen: %d | Ertelenen: %u | Kısılan: %u | Sonradan başlatılan: %u | Düşürülen: %u\n",
+           stats->waiting, stats->deferred_total, stats->throttled_total, stats->resumed_total, stats->dropped_total);
+    return 0;
+}
+
+// procx run [seçenekler] [--] <komut> [argüman...]
+// Başlatmayı domain'deki çalışan bir instance'a mesaj kuyruğu üzerinden yaptırır: process o
+// instance'ın child'ı olur, o toplar ve çıkış durumu geçmişe yazılır. Child çağıranın dizininde,
+// instance'ın ortamıyla başlar. Attached mod anlamsızdır çünkü CLI hemen çıkar.
+static int cli_run(int argc, char const *argv[])
+{
+    static RunRequest req; // Stack'i şişirmemek için statik
+    size_t len = 0;
+
+    memset(&req, 0, sizeof(req));
+    int i = parse_launch_options(argc, (char **)argv, &req.opts);
+    if (i < 0)
+        return 2;
+    if (req.opts.use_pty)
+    {
+        // PTY'nin master ucunu tutacak bir instance gerekir, CLI hemen çıkar
+        fprintf(stderr, "[HATA] --pty yalnızca çalışan bir ProcX instance'ından kullanılabilir "
+                        "(menü seçenek satırı veya procx schedule add).\n");
+        return 2;
+    }
+
+    if (i >= argc)
+    {
+        fprintf(stderr, "Kullanım: procx run [seçenekler] [--] <komut> [argüman...]\n");
+        return 2;
+    }
+
+    // Argümanları NUL ile ayırarak paketle; görünen ad yalnızca tablo içindir (sığmayan kırpılır)
+    size_t pos = 0;
+    for (; i < argc; i++)
+    {
+        size_t arg_len = strlen(argv[i]) + 1;
+        if (req.argc >= RUN_MAX_ARGS || pos + arg_len > sizeof(req.args))
+        {
+            fprintf(stderr, "[HATA] Komut çok uzun (en fazla %d argüman, toplam %d bayt).\n",
+                    RUN_MAX_ARGS, RUN_ARGS_SIZE);
+            return 2;
+        }
+        memcpy(req.args + pos, argv[i], arg_len);
+        pos += arg_len;
+        req.argc++;
+
+        if (len + 1 < sizeof(req.display))
+        {
+            if (len > 0)
+                req.display[len++] = ' ';
+            snprintf(req.display + len, sizeof(req.display) - len, "%s", argv[i]);
+            len += strlen(req.display + len);
+        }
+    }
+    if (getcwd(req.cwd, sizeof(req.cwd)) == NULL)
+    {
+        perror("[HATA] Çalışma dizini alınamadı");
+        return 1;
+    }
+
+    if (init_ipc_resources(0) == -1)
+    {
+        fprintf(stderr, "[HATA] '%s' domain'inde çalışan ProcX instance'ı yok.\n", g_domain);
+        return 1;
+    }
+
+    // İsteği ilk canlı instance'a gönder
+    pid_t instance = 0;
+    lock_shared();
+    for (int k = 0; k < g_shared_mem->instance_count && k < MAX_INSTANCES && instance == 0; k++)
+    {
+        pid_t candidate = g_shared_mem->instance_pids[k];
+        if (candidate > 0 && !(kill(candidate, 0) == -1 && errno == ESRCH))
+            instance = candidate;
+    }
+    unlock_shared();
+    if (instance == 0)
+    {
+        fprintf(stderr, "[HATA] '%s' domain'inde çalışan ProcX instance'ı yok.\n", g_domain);
+        disconnect_ipc_resources();
+        return 1;
+    }
+
+    req.msg_type = instance;
+    req.command = MSG_RUN_REQUEST;
+    req.sender_pid = getpid();
+    if (msgsnd(g_mq_id, &req, sizeof(RunRequest) - sizeof(long), IPC_NOWAIT) == -1)
+    {
+        perror("[HATA] İstek instance'a gönderilemedi");
+        disconnect_ipc_resources();
+        return 1;
+    }
+
+    // Instance fork edip exec sonucunu bildirene kadar bekle
+    Message reply;
+    int waited_ms = 0;
+    while (msgrcv(g_mq_id, &reply, sizeof(Message) - sizeof(long), getpid(), IPC_NOWAIT) == -1)
+    {
+        if (errno != ENOMSG || waited_ms >= RUN_REPLY_TIMEOUT_MS ||
+            (kill(instance, 0) == -1 && errno == ESRCH))
+        {
+            fprintf(stderr, "[HATA] Instance (PID %d) isteğe cevap vermedi.\n", instance);
+            disconnect_ipc_resources();
+            return 1;
+        }
+        usleep(10000); // 10ms
+        waited_ms += 10;
+    }
+    if (reply.error != 0)
+    {
+        fprintf(stderr, "[HATA] Process başlatılamadı: %s\n", strerror(reply.error));
+        disconnect_ipc_resources();
+        return 1;
+    }
+    disconnect_ipc_resources();
+
+    // --notify: READY=1'i instance'ın event loop'u okur, burada tablodaki durumu bekle
+    pid_t pid = reply.target_pid;
+    int rc = 0;
+    if (req.opts.notify_ready)
+    {
+        static SharedData snapshot;
+        struct timespec deadline, now;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += req.opts.ready_timeout_sec;
+
+        rc = 3;
+        while (rc == 3)
+        {
+            if (take_snapshot(&snapshot, 0) == -1)
+                return 1;
+            const ProcessInfo *proc = find_process(&snapshot, pid);
+            if (proc == NULL)
+            {
+                fprintf(stderr, "[HATA] PID %d hazır olmadan sonlandı.\n", pid);
+                rc = 1;
+            }
+            else if (proc->status != STATUS_STARTING && proc->ready_latency_ms >= 0)
+            {
+                fprintf(stderr, "[READY] PID %d %ld ms içinde hazır.\n", pid, proc->ready_latency_ms);
+                rc = 0;
+            }
+            else
+            {
+                // Instance da aynı süre dolunca Running'e geçirir (ready_latency_ms -1)
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                int expired = now.tv_sec > deadline.tv_sec ||
+                              (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec);
+                if (expired)
+                {
+                    fprintf(stderr, "[HATA] PID %d %d saniye içinde hazır olmadı.\n", pid, req.opts.ready_timeout_sec);
+                    break;
+                }
+                if (proc->status != STATUS_STARTING)
+                {
+                    fprintf(stderr, "[HATA] PID %d READY=1 göndermeden bildirim fd'sini kapattı.\n", pid);
+                    rc = 1;
+                }
+                else
+                {
+                    usleep(10000); // 10ms
+                }
+            }
+        }
+    }
+
+    printf("%d\n", pid);
+    return rc;
+}
+
+// procx schedule add|ls|rm ...
+static int cli_schedule(int argc, char const *argv[])
+{
+    if (argc >= 1 && strcmp(argv[0], "add") == 0)
+    {
+        if (init_ipc_resources(0) == -1)
+        {
+            fprintf(stderr, "[HATA] '%s' domain'inde çalışan ProcX instance'ı yok.\n", g_domain);
+            return 1;
+        }
+        unsigned int id = schedule_add(argc - 1, (char **)argv + 1);
+        disconnect_ipc_resources();
+        if (id == 0)
+            return 1;
+        printf("%u\n", id);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[0], "rm") == 0)
+    {
+        char *end;
+        long id = strtol(argv[1], &end, 10);
+        if (*end != '\0' || id <= 0)
+        {
+            fprintf(stderr, "[HATA] Geçersiz görev numarası: %s\n", argv[1]);
+            return 2;
+        }
+        if (init_ipc_resources(0) == -1)
+        {
+            fprintf(stderr, "[HATA] Görev #%ld bulunamadı.\n", id);
+            return 1;
+        }
+        int rc = schedule_remove((unsigned int)id);
+        disconnect_ipc_resources();
+        if (rc == -1)
+        {
+            fprintf(stderr, "[HATA] Görev #%ld bulunamadı.\n", id);
+            return 1;
+        }
+        return 0;
+    }
+
+    if (argc >= 1 && strcmp(argv[0], "ls") == 0)
+    {
+        static SharedData snapshot;
+        if (take_snapshot(&snapshot, 1) == -1)
+            return 1;
+
+        if (argc < 2 || strcmp(argv[1], "--json") != 0)
+        {
+            print_schedules(&snapshot);
+            return 0;
+        }
+
+        printf("{\"scheduler_pid\":%d,\"schedules\":[", snapshot.scheduler_pid);
+        int first = 1;
+        for (int i = 0; i < snapshot.schedule_high; i++)
+        {
+            const ScheduleInfo *sched = &snapshot.schedules[i];
+            if (!sched->in_use)
+                continue;
+
+            printf("%s{\"id\":%u,\"kind\":\"%s\",", first ? "" : ",", sched->id,
+                   sched->kind == SCHED_FIXED_RATE ? "fixed-rate" : sched->kind == SCHED_CRON ? "cron" : "oneshot");
+            if (sched->kind == SCHED_FIXED_RATE)
+                printf("\"interval\":%ld,", sched->interval_sec);
+            if (sched->kind == SCHED_CRON)
+            {
+                printf("\"cron\":");
+                print_json_string(sched->cron_expr);
+                printf(",");
+            }
+            printf("\"next_run\":%ld,\"skip_if_running\":%s,\"runs\":%u,\"skips\":%u,\"last_pid\":%d,"
+                   "\"mode\":\"%s\",\"profile\":",
+                   (long)sched->next_run, sched->skip_if_running ? "true" : "false",
+                   sched->run_count, sched->skip_count, sched->last_pid,
+                   sched->mode == MODE_ATACHED ? "attached" : "detached");
+            print_json_string(sched->opts.profile);
+            printf(",\"command\":");
+            print_json_string(sched->command);
+            printf("}");
+            first = 0;
+        }
+        printf("]}\n");
+        return 0;
+    }
+
+    fprintf(stderr, "Kullanım: procx schedule add|ls [--json]|rm <id>\n");
+    return 2;
+}
+
+// procx attach <pid>
+// Process'i başlatan instance'ın attach soketine bağlanır, scrollback'i basar ve
+// terminali process'in PTY'sine bağlar. Ctrl-] ile ayrılınır, process çalışmaya devam eder.
+static int cli_attach(pid_t pid)
+{
+    static SharedData snapshot;
+    if (take_snapshot(&snapshot, 0) == -1)
+    {
+        return 1;
+    }
+    const ProcessInfo *proc = find_process(&snapshot, pid);
+    if (proc == NULL)
+    {
+        fprintf(stderr, "[HATA] PID %d ProcX tarafından yönetilmiyor.\n", pid);
+        return 1;
+    }
+    if (!proc->launch.use_pty)
+    {
+        fprintf(stderr, "[HATA] PID %d PTY ile başlatılmadı (--pty).\n", pid);
+        return 1;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), ATTACH_SOCK_FMT, g_private_dir, proc->owner_pid);
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock == -1 || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) == -1)
+    {
+        fprintf(stderr, "[HATA] Instance %d'ye bağlanılamadı: %s\n", proc->owner_pid, strerror(errno));
+        if (sock != -1)
+            close(sock);
+        return 1;
+    }
+
+    // Dinleyen gerçekten bu kullanıcının o instance'ı mı? (tuşlar başkasına gitmesin)
+    pid_t peer_pid;
+    if (check_peer(sock, &peer_pid) == -1 || (peer_pid != 0 && peer_pid != proc->owner_pid))
+    {
+        fprintf(stderr, "[HATA] %s başka bir process tarafından dinleniyor, bağlanılmadı.\n", addr.sun_path);
+        close(sock);
+        return 1;
+    }
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+
+    // İsteği gönder, terminal boyutunu da bildir
+    struct winsize ws;
+    memset(&ws, 0, sizeof(ws));
+    ioctl(STDIN_FILENO, TIOCGWINSZ, &ws);
+    char line[128];
+    snprintf(line, sizeof(line), "ATTACH %d %d %d\n", pid, ws.ws_row, ws.ws_col);
+    send_all(sock, line, strlen(line));
+
+    // Cevap satırını bayt bayt oku (arkasından scrollback gelir)
+    size_t len = 0;
+    while (len < sizeof(line) - 1 && read(sock, line + len, 1) == 1 && line[len] != '\n')
+        len++;
+    line[len] = '\0';
+    if (strcmp(line, "OK") != 0)
+    {
+        fprintf(stderr, "[HATA] %s\n", strncmp(line, "ERR ", 4) == 0 ? line + 4 : "Bağlantı reddedildi");
+        close(sock);
+        return 1;
+    }
+
+    // Tuşlar doğrudan process'e gitsin diye terminali raw moda al
+    struct termios saved, raw;
+    int is_tty = isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &saved) == 0;
+    if (is_tty)
+    {
+        raw = saved;
+        cfmakeraw(&raw);
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+    fprintf(stderr, "[ATTACH] PID %d'ye bağlanıldı (ayrılmak için Ctrl-])\r\n", pid);
+
+    struct pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {sock, POLLIN, 0}};
+    char data[4096];
+    int detached = 0;
+    int stdin_open = 1;
+    while (1)
+    {
+        if (poll(fds, 2, -1) == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[1].revents != 0)
+        {
+            ssize_t n = read(sock, data, sizeof(data));
+            if (n <= 0)
+                break; // Process terminali kapandı veya instance çıktı
+            write(STDOUT_FILENO, data, n);
+        }
+
+        if (stdin_open && fds[0].revents != 0)
+        {
+            ssize_t n = read(STDIN_FILENO, data, sizeof(data));
+            if (n <= 0)
+            {
+                stdin_open = 0;
+                fds[0].fd = -1; // poll negatif fd'yi yok sayar
+                continue;
+            }
+            char *key = memchr(data, DETACH_KEY, n);
+            if (key != NULL)
+            {
+                send_all(sock, data, key - data);
+                detached = 1;
+                break;
+            }
+            send_all(sock, data, n);
+        }
+    }
+
+    if (is_tty)
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    close(sock);
+    fprintf(stderr, detached ? "\n[ATTACH] Ayrılındı, PID %d çalışmaya devam ediyor.\n"
+                             : "\n[ATTACH] PID %d bağlantısı kapandı.\n", pid);
+    return 0;
+}
+
+// procx kill <pid>
+// Yalnızca ProcX tablosunda kayıtlı process'lere sinyal gönderir.
+static int cli_kill(pid_t pid)
+{
+    static SharedData snapshot;
+    if (take_snapshot(&snapshot, 0) == -1)
+    {
+        return 1;
+    }
+    if (find_process(&snapshot, pid) == NULL)
+    {
+        fprintf(stderr, "[HATA] PID %d ProcX tarafından yönetilmiyor.\n", pid);
+        return 1;
+    }
+    if (kill(pid, SIGTERM) == -1)
+    {
+        perror("Process sonlandırma hatası");
+        return 1;
+    }
+    return 0;
+}
+
+// Geçmişte PID'ye ait en yeni kaydı bulur
+static const ExitRecord *find_exit_record(const SharedData *data, pid_t pid)
+{
+    unsigned int count = data->history_total < MAX_HISTORY ? data->history_total : MAX_HISTORY;
+    for (unsigned int n = 1; n <= count; n++)
+    {
+        const ExitRecord *rec = &data->history[(data->history_total - n) % MAX_HISTORY];
+        if (rec->pid == pid)
+        {
+            return rec;
+        }
+    }
+    return NULL;
+}
 
-    // Yazma ucunu kapatırken close-on-exec bayrağını ayarla
-    // Bu sayede eğer execvp başarılı olursa pipe kapanır
-    if (fcntl(pipe_fd[1], F_SETFD, FD_CLOEXEC) == -1)
+// procx history [--json]
+static int cli_history(int json)
+{
+    static SharedData snapshot;
+    if (take_snapshot(&snapshot, 0) == -1)
     {
-        perror("fcntl hatası");
-        close(pipe_fd[0]);
-        close(pipe_fd[1]);
-        return;
+        return 1;
     }
-    
-    // Yeni process oluştur
-    pid = fork();
 
-    if (pid < 0)
+    if (!json)
     {
-        perror("Fork hatası");
-        // Pipe'ı kapat
-        close(pipe_fd[0]);
-        close(pipe_fd[1]);
-        return;
+        print_exit_history(&snapshot);
+        return 0;
     }
 
-    // --- CHILD PROCESS ---
-    else if (pid == 0)
+    printf("{\"history\":[");
+    unsigned int count = snapshot.history_total < MAX_HISTORY ? snapshot.history_total : MAX_HISTORY;
+    for (unsigned int n = 1; n <= count; n++)
     {
-        char *argv[MAX_ARGS];
+        const ExitRecord *rec = &snapshot.history[(snapshot.history_total - n) % MAX_HISTORY];
 
-        // Pipe'ın okuma ucunu kapat
-        close(pipe_fd[0]);
+        printf("%s{\"pid\":%d,\"owner_pid\":%d,\"command\":", n == 1 ? "" : ",", rec->pid, rec->owner_pid);
+        print_json_string(rec->command);
+        printf(",\"mode\":\"%s\",\"start_time\":%ld,\"end_time\":%ld,",
+               rec->mode == MODE_ATACHED ? "attached" : "detached",
+               (long)rec->start_time, (long)rec->end_time);
+        if (rec->status_known)
+            printf("\"exit_code\":%d,\"signal\":%d,", rec->exit_code, rec->term_signal);
+        else
+            printf("\"exit_code\":null,\"signal\":null,");
+        printf("\"user_ms\":%ld,\"sys_ms\":%ld,\"max_rss_kb\":%ld}",
+               rec->user_time_ms, rec->sys_time_ms, rec->max_rss_kb);
+    }
+    printf("]}\n");
+    return 0;
+}
+
+// procx wait --ready [--timeout SEC] <pid>
+// Process Starting'den çıkana kadar bekler. READY=1 geldiyse 0, sonlandıysa veya READY
+// göndermeden Running sayıldıysa 1, timeout_sec (0: sınırsız) dolduysa 3 döner.
+static int cli_wait_ready(pid_t pid, int timeout_sec)
+{
+    static SharedData snapshot;
+    struct timespec deadline, now;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_sec;
 
-        // Komutu tokenize et
-        int arg_count = parse_command(command_for_tokenize, argv);
+    while (1)
+    {
+        if (take_snapshot(&snapshot, 0) == -1)
+            return 1;
 
-        if (arg_count == 0)
+        const ProcessInfo *proc = find_process(&snapshot, pid);
+        if (proc == NULL)
         {
-            // Hata durumunda pipe'a yaz
-            int err = ENOENT;
-            write(pipe_fd[1], &err, sizeof(err));
-            exit(EXIT_FAILURE);
+            fprintf(stderr, "[HATA] PID %d ProcX tarafından yönetilmiyor veya sonlandı.\n", pid);
+            return 1;
         }
-
-        if (mode == MODE_DETACHED)
+        if (proc->status == STATUS_RUNNING)
         {
-            if (setsid() < 0)
-            {
-                // Hata durumunda pipe'a yaz
-                int err = errno;
-                write(pipe_fd[1], &err, sizeof(err));
-                exit(EXIT_FAILURE);
-            }
+            if (proc->ready_latency_ms >= 0 || !proc->launch.notify_ready)
+                return 0;
+            fprintf(stderr, "[HATA] PID %d READY=1 göndermeden Running sayıldı.\n", pid);
+            return 1;
         }
 
-        // Programı çalıştır (argv[0] komutun kendisidir)
-        execvp(argv[0], argv);
-
-        // Buraya gelindiyse execvp başarısız olmuştur
-        int err = errno;
-        write(pipe_fd[1], &err, sizeof(err)); // Parent'a hata kodunu yaz
-        
-        // Pipe'ın yazma ucunu kapat
-        close(pipe_fd[1]);
-
-        // Hata durumunda (Komut bulunamazsa)
-        perror("execvp hatası (Komut bulunamadı veya çalıştırılamadı)");
-        exit(EXIT_FAILURE);
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (timeout_sec > 0 && (now.tv_sec > deadline.tv_sec ||
+                                (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec)))
+        {
+            fprintf(stderr, "[HATA] PID %d %d saniye içinde hazır olmadı.\n", pid, timeout_sec);
+            return 3;
+        }
+        usleep(10000); // 10ms
     }
+}
 
-    // --- PARENT PROCESS  ---
-
-    // Pipe'ın yazma ucunu kapat
-    close(pipe_fd[1]);
-
-    // Child process'ten hata kodunu oku
-    int child_err;
-    ssize_t n = read(pipe_fd[0], &child_err, sizeof(child_err));
-
-    // Pipe'ın okuma ucunu kapat
-    close(pipe_fd[0]);
+// procx wait <pid>
+// Process tablodan düşene (veya sistemde yok olana) kadar bekler.
+// Çıkış durumu geçmişte varsa onu döner (sinyal ile sonlandıysa 128 + sinyal),
+// bilinmiyorsa WAIT_STATUS_UNKNOWN.
+static int cli_wait(pid_t pid)
+{
+    static SharedData snapshot;
+    if (take_snapshot(&snapshot, 0) == -1)
+    {
+        return 1;
+    }
+    if (find_process(&snapshot, pid) == NULL)
+    {
+        fprintf(stderr, "[HATA] PID %d ProcX tarafından yönetilmiyor.\n", pid);
+        return 1;
+    }
 
-    // Eğer read 0 döndüyse, child process execvp ile başarılı bir şekilde değişti
-    if (n > 0)
+    while (1)
     {
-        // Pipe'tan veri geldi, demek ki execvp başarısız oldu
-        fprintf(stderr, "HATA: Process başlatılamadı. Komut hatası veya bulunamadı. (Hata Kodu: %d)\n", child_err);
+        // Monitor thread'i süreci toplayana kadar tablo kaydı kalabilir,
+        // bu yüzden süreç sistemde yoksa da beklemeyi bitir
+        if (kill(pid, 0) == -1 && errno == ESRCH)
+            break;
 
-        // Zombi process oluşmaması için waitpid çağır
-        waitpid(pid, NULL, 0);
-        return;
+        usleep(50000); // 50ms
+
+        if (take_snapshot(&snapshot, 0) == -1)
+            return 1;
+        if (find_process(&snapshot, pid) == NULL)
+            break;
     }
 
-    // Buraya gelindiyse child process execvp ile başarılı bir şekilde değişti
-    // Process ID'si pid değişkeninde
-    // Hemen waitpid ile kontrol et (WNOHANG ile non-blocking)
-    int status;
-    pid_t result = waitpid(pid, &status, WNOHANG);
-    if (result < 0)
+    // Monitor kaydı yazana kadar kısa bir süre bekle (en fazla bir tarama periyodu)
+    for (int attempt = 0; attempt < 50; attempt++)
     {
-        // Child process hemen sonlandı, demek ki execvp başarısız oldu
-        // Shared memory'e ekleme yapma
-        fprintf(stderr, "HATA: Process başlatılamadı. Komut hatası veya bulunamadı.\n");
-        return;
+        const ExitRecord *rec = find_exit_record(&snapshot, pid);
+        if (rec != NULL)
+        {
+            if (!rec->status_known)
+            {
+                fprintf(stderr, "[UYARI] PID %d sonlandı, çıkış durumu bilinmiyor (sahibi toplayamadı).\n", pid);
+                return WAIT_STATUS_UNKNOWN;
+            }
+            return rec->term_signal != 0 ? 128 + rec->term_signal : rec->exit_code;
+        }
+        if (find_process(&snapshot, pid) == NULL && attempt > 0)
+            break; // Tablodan düştü ama kayıt yok (ör. instance yok)
+        usleep(50000);
+        if (take_snapshot(&snapshot, 0) == -1)
+            return 1;
     }
+    fprintf(stderr, "[UYARI] PID %d sonlandı, çıkış durumu kaydedilmedi.\n", pid);
+    return WAIT_STATUS_UNKNOWN;
+}
 
-    // Shared Memory'ye process bilgisini ekle
-    sem_wait(g_sem); // Kilidi al
+// procx domains [--json]
+// Bu kullanıcının domain'lerini anahtar dosyalarından bulur ve her birinin
+// shared memory'sini salt-okunur eşleyerek özetler.
+static int cli_domains(int json)
+{
+    const char *prefix = IPC_KEY_PREFIX;
+    size_t prefix_len = strlen(prefix);
 
-    int max_processes = sizeof(g_shared_mem->processes) / sizeof(g_shared_mem->processes[0]);
-    if (g_shared_mem->process_count >= max_processes)
+    // Özel dizin yoksa bu kullanıcı hiç instance başlatmamıştır: liste boş
+    DIR *dir = NULL;
+    if (open_private_dir(0) == 0 && (dir = opendir(g_private_dir)) == NULL)
     {
-        fprintf(stderr, "HATA: Shared memory dolu (Maksimum %d sürece ulaşıldı).\n", max_processes);
-        sem_post(g_sem); // Kilidi aç
-        return;
+        perror("Domain listesi okunamadı");
+        return 1;
     }
 
-    // Process Bilgisini Doldurma
-    ProcessInfo *new_proc = &g_shared_mem->processes[g_shared_mem->process_count];
-
-    new_proc->pid = pid;
-    new_proc->owner_pid = getpid();
-    new_proc->mode = mode;
-    new_proc->status = 0; // Running
+    static SharedData snapshot;
+    char current[MAX_DOMAIN_LEN + 1];
+    strcpy(current, g_domain);
+    int first = 1;
 
-    // Kaydedilen orijinal komutu kopyala
-    strncpy(new_proc->command, command_for_save, sizeof(new_proc->command) - 1);
-    new_proc->command[sizeof(new_proc->command) - 1] = '\0';
+    if (json)
+        printf("{\"domains\":[");
+    else
+        printf("%-20s %9s %8s %8s\n", "DOMAIN", "INSTANCE", "PROCESS", "GÖREV");
 
-    new_proc->start_time = time(NULL);
-    new_proc->is_active = 1;
+    struct dirent *entry;
+    while (dir != NULL && (entry = readdir(dir)) != NULL)
+    {
+        if (strncmp(entry->d_name, prefix, prefix_len) != 0)
+            continue;
+        const char *name = entry->d_name + prefix_len;
+        if (set_domain(name) == -1)
+            continue;
 
-    g_shared_mem->process_count++;
+        // Segment yoksa domain'in son instance'ı temizlik yapamadan çıkmış demektir
+        int active = (attach_shared_readonly() != NULL);
+        if (!active || snapshot_shared(g_shared_mem, &snapshot, 1) == -1)
+            memset(&snapshot, 0, SNAPSHOT_CORE); // schedule_high 0: görev tablosu okunmaz
+        disconnect_ipc_resources();
 
-    sem_post(g_sem); // Kilidi bırak
+        int schedules = 0;
+        for (int i = 0; i < snapshot.schedule_high; i++)
+            schedules += snapshot.schedules[i].in_use ? 1 : 0;
 
-    // 4. IPC Bildirimi Gönder
-    Message ipc_msg;
-    ipc_msg.msg_type = 1;
-    ipc_msg.command = STATUS_CREATED;
-    ipc_msg.sender_pid = getpid();
-    ipc_msg.target_pid = pid;
-    send_ipc_message(&ipc_msg);
+        if (json)
+        {
+            printf("%s{\"name\":", first ? "" : ",");
+            print_json_string(name);
+            printf(",\"active\":%s,\"instances\":%d,\"processes\":%d,\"schedules\":%d,\"current\":%s}",
+                   active ? "true" : "false", snapshot.instance_count, snapshot.process_count, schedules,
+                   strcmp(name, current) == 0 ? "true" : "false");
+        }
+        else
+        {
+            printf("%-20s %9d %8d %8d%s%s\n", name, snapshot.instance_count, snapshot.process_count, schedules,
+                   active ? "" : "  (segment yok, procx --domain ... clean)",
+                   strcmp(name, current) == 0 ? "  *" : "");
+        }
+        first = 0;
+    }
+    if (dir != NULL)
+        closedir(dir);
+    set_domain(current);
 
-    pthread_mutex_lock(&g_ui_mutex);
-    printf("[SUCCESS] Process başlatıldı: PID %d (Mod: %s)\n", pid,
-           (mode == MODE_DETACHED ? "Detached" : "Attached"));
-    fflush(stdout);
-    pthread_mutex_unlock(&g_ui_mutex);
+    if (json)
+        printf("]}\n");
+    return 0;
 }
 
-// Process'i sonlandırma fonksiyonu
-void terminate_process(pid_t target_pid)
+// procx clean [--force]
+// Takılı kalmış IPC kaynaklarını (çökmüş instance'lardan kalan) ve sahibi ölmüş attach
+// soketlerini siler. Domain'de yaşayan instance varsa --force verilmedikçe dokunmaz:
+// kaynakları altından çekilen instance'lar çalışmaya devam edip tutarsız kalırdı.
+static int cli_clean(int force)
 {
-    if (g_sem == NULL || g_shared_mem == NULL)
+    static SharedData snapshot;
+    if (take_snapshot(&snapshot, 0) == -1)
+        return 1;
+    disconnect_ipc_resources();
+
+    int alive = 0;
+    for (int i = 0; i < snapshot.instance_count && i < MAX_INSTANCES; i++)
     {
-        fprintf(stderr, "[HATA] Shared Memory veya Semafor başlatılmamış.\n");
-        return;
+        pid_t pid = snapshot.instance_pids[i];
+        if (pid > 0 && !(kill(pid, 0) == -1 && errno == ESRCH))
+        {
+            if (!force)
+                fprintf(stderr, "[HATA] Instance çalışıyor: PID %d\n", pid);
+            alive++;
+        }
     }
-    // Sinyal gönder
-    if (kill(target_pid, SIGTERM) == 0)
+    if (alive > 0 && !force)
     {
-        pthread_mutex_lock(&g_ui_mutex);
-        printf("[INFO] Process %d için sonlandırma emri (SIGTERM) verildi.\n", target_pid);
-        fflush(stdout);
-        pthread_mutex_unlock(&g_ui_mutex);
+        fprintf(stderr, "[HATA] '%s' domain'inde %d instance çalışıyor; önce onları kapatın "
+                        "veya procx clean --force kullanın.\n", g_domain, alive);
+        return 1;
     }
-    else
+
+    remove_stale_attach_sockets();
+
+    key_t key = ftok(g_ipc_key_file, 65);
+    if (key != -1)
     {
-        perror("Process sonlandırma hatası");
+        g_mq_id = msgget(key, 0);
     }
+    destroy_ipc_resources();
+    return 0;
 }
 
-// UI Menüsü Basma Fonksiyonu
-void print_program_output()
+static void print_cli_usage()
 {
-    printf("\r\033[K"); // Satırı temizle
-    printf("╔════════════════════════════════════╗\n");
-    printf("║             ProcX v1.0             ║\n");
-    printf("╠════════════════════════════════════╣\n");
-    printf("║ 1. Yeni Program Çalıştır           ║\n");
-    printf("║ 2. Çalışan Programları Listele     ║\n");
-    printf("║ 3. Program Sonlandır               ║\n");
-    printf("║ 0. Çıkış                           ║\n");
-    printf("╚════════════════════════════════════╝\n");
-    printf("Seçiminiz: ");
+    fprintf(stderr,
+            "Kullanım: procx [--domain NAME] [alt komut]   (varsayılan: $" DOMAIN_ENV " veya " DEFAULT_DOMAIN ")\n"
+            "  procx                       Etkileşimli menü\n"
+            "  procx ls [--json]           Çalışan process'leri listele\n"
+            "  procx run [seçenekler] [--] <komut...>\n"
+            "                              Process'i Detached modda başlat, PID'yi yaz\n"
+            "      --profile default|service|batch|idle\n"
+            "      --nice N  --ioprio rt|be|idle[:0-7]  --oom N\n"
+            "      --mem SIZE[K|M|G]  --nofile N  --cpu SEC\n"
+            "      --notify [--ready-timeout SEC]  READY=1 bekle ($" NOTIFY_ENV ")\n"
+            "      --pty                   PTY ile başlat (yalnızca menü/schedule)\n"
+            "  procx attach <pid>          PTY'ye bağlan (Ctrl-] ile ayrıl)\n"
+            "  procx kill <pid>            Process'e SIGTERM gönder\n"
+            "  procx wait <pid>            Process sonlanana kadar bekle\n"
+            "  procx wait --ready [--timeout SEC] <pid>\n"
+            "                              Process READY=1 bildirene kadar bekle\n"
+            "  procx history [--json]      Sonlanan process'leri listele\n"
+            "  procx pressure [--json]     PSI değerleri ve kabul kontrolü sayaçları\n"
+            "  procx top [--interval SEC] [--sort runtime|owner|mode|pid] [--filter TEXT] [--count N]\n"
+            "                              Canlı tablo (q: çıkış, s: sıralama, /: filtre, n/p: sayfa)\n"
+            "  procx schedule add (--in SEC | --at HH:MM | --every SEC | --cron \"m h dom mon dow\")\n"
+            "                 [--skip-if-running] [--detached] [seçenekler] [--] <komut...>\n"
+            "  procx schedule ls [--json]  Zamanlanmış görevleri listele\n"
+            "  procx schedule rm <id>      Görevi sil\n"
+            "  procx domains [--json]      Bu kullanıcının domain'lerini listele\n"
+            "  procx clean [--force]       Domain'in IPC kaynaklarını sil (--force: instance çalışsa da)\n");
 }
 
-// Çalışan processleri listeleme fonksiyonu
-void print_running_processes(SharedData *data)
+// Etkileşimsiz alt komutları çalıştırır ve çıkış kodunu döner.
+// Bu yol instance sayacını artırmaz ve thread başlatmaz.
+int run_cli(int argc, char const *argv[])
 {
-    pthread_mutex_lock(&g_ui_mutex);
-    time_t now = time(NULL);
-    char duration_str[20]; // Süreyi "5s" şeklinde tutmak için geçici alan
-
-    printf("╔═══════╤═════════════════╤══════════╤════════════╤════════════╗\n");
-    printf("║ %-5s │ %-15s │ %-8s │ %-10s │ %-10s  ║\n",
-           "PID", "Command", "Mode", "Status", "Süre");
-    printf("╠═══════╪═════════════════╪══════════╪════════════╪════════════╣\n");
+    const char *cmd = argv[1];
 
-    for (int i = 0; i < data->process_count; i++)
+    if (strcmp(cmd, "ls") == 0)
     {
-        ProcessInfo *proc = &data->processes[i];
-        if (proc->is_active)
+        int json = (argc > 2 && strcmp(argv[2], "--json") == 0);
+        return cli_list(json);
+    }
+    if (strcmp(cmd, "top") == 0)
+    {
+        return cli_top(argc - 2, argv + 2);
+    }
+    if (strcmp(cmd, "pressure") == 0)
+    {
+        int json = (argc > 2 && strcmp(argv[2], "--json") == 0);
+        return cli_pressure(json);
+    }
+    if (strcmp(cmd, "history") == 0)
+    {
+        int json = (argc > 2 && strcmp(argv[2], "--json") == 0);
+        return cli_history(json);
+    }
+    if (strcmp(cmd, "run") == 0)
+    {
+        return cli_run(argc - 2, argv + 2);
+    }
+    if (strcmp(cmd, "wait") == 0 && argc > 3 && strcmp(argv[2], "--ready") == 0)
+    {
+        char *end;
+        long timeout = 0;
+        int arg = 3;
+        if (argc > 5 && strcmp(argv[3], "--timeout") == 0)
         {
-            long elapsed_seconds = (long)difftime(now, proc->start_time);
-
-            // Önce süreyi "5s" formatında bir metne dönüştür
-            snprintf(duration_str, sizeof(duration_str), "%lds", elapsed_seconds);
-
-            printf(
-                "║ %-5d │ %-15.15s │ %-8s │ %-10s │ %-10s ║\n",
-                proc->pid,
-                proc->command,
-                proc->mode == MODE_ATACHED ? "Attached" : "Detached",
-                proc->status == STATUS_RUNNING ? "Running" : "Terminated",
-                duration_str); // Artık metin olarak (bitişik) yazdırıyoruz
+            if (parse_ranged_int(argv[4], 1, 86400, &timeout) == -1)
+            {
+                fprintf(stderr, "[HATA] Geçersiz süre: %s (1-86400 sn)\n", argv[4]);
+                return 2;
+            }
+            arg = 5;
         }
+        long pid = strtol(argv[arg], &end, 10);
+        if (*end != '\0' || pid <= 0)
+        {
+            fprintf(stderr, "[HATA] Geçersiz PID: %s\n", argv[arg]);
+            return 2;
+        }
+        return cli_wait_ready((pid_t)pid, (int)timeout);
     }
-    printf("╚═══════╧═════════════════╧══════════╧════════════╧════════════╝\n");
-    pthread_mutex_unlock(&g_ui_mutex);
-}
-
-// Ekranı temizleyip mesajı ve menüyü yeniden basan fonksiyon
-void repaint_ui(const char *message)
-{
-    pthread_mutex_lock(&g_ui_mutex);
-
-    // 1. İmleci satır başına al ve satırı temizle
-    printf("\r\033[K");
-
-    if (message != NULL)
+    if ((strcmp(cmd, "kill") == 0 || strcmp(cmd, "wait") == 0 || strcmp(cmd, "attach") == 0) && argc > 2)
+    {
+        char *end;
+        long pid = strtol(argv[2], &end, 10);
+        if (*end != '\0' || pid <= 0)
+        {
+            fprintf(stderr, "[HATA] Geçersiz PID: %s\n", argv[2]);
+            return 2;
+        }
+        if (cmd[0] == 'a')
+            return cli_attach((pid_t)pid);
+        return cmd[0] == 'k' ? cli_kill((pid_t)pid) : cli_wait((pid_t)pid);
+    }
+    if (strcmp(cmd, "schedule") == 0)
     {
-        // 2. Mesajı bas ve alt satıra geç
-        printf(">>> %s\n", message);
+        return cli_schedule(argc - 2, argv + 2);
+    }
+    if (strcmp(cmd, "domains") == 0)
+    {
+        int json = (argc > 2 && strcmp(argv[2], "--json") == 0);
+        return cli_domains(json);
+    }
+    if (strcmp(cmd, "clean") == 0)
+    {
+        int force = (argc > 2 && strcmp(argv[2], "--force") == 0);
+        return cli_clean(force);
     }
 
-    // 3. Prompt'u (İstemciyi) tekrar göster
-    printf("Seçiminiz: ");
-
-    fflush(stdout);
-    pthread_mutex_unlock(&g_ui_mutex);
+    print_cli_usage();
+    return 2;
 }
 
-void signal_handler(int signum)
+int main(int argc, char const *argv[])
 {
-    int saved_errno = errno;
-    if (signum == SIGCHLD)
+    // --domain NAME (veya PROCX_DOMAIN): IPC kaynaklarını ayrı bir isim alanında aç
+    const char *domain = getenv(DOMAIN_ENV);
+    if (argc > 2 && strcmp(argv[1], "--domain") == 0)
     {
-        // Child process sonlandığında yapılacak işlemler
-        // Burada herhangi bir işlem yapmıyoruz, monitor thread süreci kontrol edecek
-        // İlgili child process'i waitpid ile toplamak monitor thread'in işi
-        // Eğer burada waitpid çağırırsak monitor thread ile çakışabiliriz
+        domain = argv[2];
+        argv[2] = argv[0]; // Kalan argümanlar "procx <alt komut> ..." gibi görünsün
+        argv += 2;
+        argc -= 2;
     }
-    else if (signum == SIGINT || signum == SIGTERM)
+    if (set_domain(domain != NULL && domain[0] != '\0' ? domain : DEFAULT_DOMAIN) == -1)
     {
-        g_shutdown = 1;
+        fprintf(stderr, "[HATA] Geçersiz domain adı: %s (harf, rakam, '-', '_'; en fazla %d karakter)\n",
+                domain, MAX_DOMAIN_LEN);
+        return 2;
     }
-    errno = saved_errno;
-}
+    // Başlatılan process'ler içinden çağrılan procx aynı domain'i kullansın
+    setenv(DOMAIN_ENV, g_domain, 1);
 
-int main(int argc, char const *argv[])
-{
-    (void)argc; // Makefile unused parameter warning go away
-    (void)argv; // Makefile unused parameter warning go away
+    // Alt komut verildiyse menüyü açmadan cevap ver ve çık
+    if (argc > 1)
+    {
+        return run_cli(argc, argv);
+    }
 
     // Sinyal işleyici yapısı
     struct sigaction sa;
@@ -791,10 +6004,29 @@ int main(int argc, char const *argv[])
     sigaction(SIGTERM, &sa, NULL);
 
     // IPC kaynaklarını başlat
-    init_ipc_resources();
+    init_ipc_resources(1);
     // Thread'leri başlat
     pthread_t monitor_thread;
     pthread_t ipc_thread;
+    pthread_t loop_thread;
+    pthread_t spawner_threads[SPAWNER_THREADS];
+
+    // Event loop'u uyandırma pipe'ı. İki uç da non-blocking: boşaltırken takılmasın,
+    // pipe dolarsa yazan thread beklemesin (bekleyen bir bayt zaten uyandırır).
+    if (pipe_cloexec(g_wake_pipe, O_NONBLOCK) == -1)
+    {
+        perror("Wake pipe oluşturulamadı");
+        exit(1);
+    }
+
+    // PTY'lere başka terminallerden bağlanmak için (açılamazsa yalnızca attach çalışmaz)
+    open_attach_socket();
+
+    // Baskı izleme (trigger kurulamazsa başlatmalar bekletilmez)
+    init_psi();
+
+    // Bildirim birleştirme penceresi ve hız sınırı
+    init_notices();
 
     if (pthread_create(&monitor_thread, NULL, monitor_processes, NULL) != 0)
     {
@@ -806,6 +6038,19 @@ int main(int argc, char const *argv[])
         perror("Listener thread oluşturulamadı");
         exit(1);
     }
+    if (pthread_create(&loop_thread, NULL, event_loop, NULL) != 0)
+    {
+        perror("Event loop thread oluşturulamadı");
+        exit(1);
+    }
+    for (int i = 0; i < SPAWNER_THREADS; i++)
+    {
+        if (pthread_create(&spawner_threads[i], NULL, spawner_thread, NULL) != 0)
+        {
+            perror("Spawner thread oluşturulamadı");
+            exit(1);
+        }
+    }
 
     // Ana döngü
     int choice;
@@ -813,6 +6058,7 @@ int main(int argc, char const *argv[])
     int mode_choice;
     pid_t pid_input;
     char input_buffer[256]; // Kullanıcı girişi için tampon
+    char options_buffer[256]; // Başlatma seçenekleri için tampon
 
     while (!g_shutdown)
     {
@@ -875,7 +6121,37 @@ int main(int argc, char const *argv[])
             scanf("%d", &mode_choice);
             while (getchar() != '\n')
                 ; // Temizlik
-            create_new_process(command_buffer, (ProcessMode)mode_choice);
+
+            pthread_mutex_lock(&g_ui_mutex);
+            printf("Başlatma seçenekleri (boş: varsayılan, ör. --profile batch --mem 512M): ");
+            fflush(stdout);
+            pthread_mutex_unlock(&g_ui_mutex);
+
+            if (fgets(options_buffer, sizeof(options_buffer), stdin) == NULL)
+                options_buffer[0] = '\0';
+
+            {
+                // Seçenekleri boşluklara göre ayır
+                char *opt_argv[32];
+                int opt_argc = 0;
+                char *token = strtok(options_buffer, " \t\n");
+                while (token != NULL && opt_argc < 32)
+                {
+                    opt_argv[opt_argc++] = token;
+                    token = strtok(NULL, " \t\n");
+                }
+
+                LaunchOptions launch_opts;
+                int consumed = parse_launch_options(opt_argc, opt_argv, &launch_opts);
+                if (consumed < 0)
+                    break;
+                if (consumed < opt_argc)
+                {
+                    fprintf(stderr, "[HATA] Beklenmeyen argüman: %s\n", opt_argv[consumed]);
+                    break;
+                }
+                create_new_process(command_buffer, (ProcessMode)mode_choice, &launch_opts);
+            }
             break;
         case 2: // Çalışan programları listele
             // Çalışan processleri shared memory'den okuyacağımız için
@@ -895,6 +6171,63 @@ int main(int argc, char const *argv[])
 
             terminate_process(pid_input);
             break;
+        case 4: // Sonlanan programları listele
+            sem_wait(g_sem);
+            print_exit_history(g_shared_mem);
+            sem_post(g_sem);
+            break;
+        case 5: // Zamanlanmış görevler
+            sem_wait(g_sem);
+            print_schedules(g_shared_mem);
+            sem_post(g_sem);
+
+            pthread_mutex_lock(&g_ui_mutex);
+            printf("Görev (add --every 30 [seçenekler] -- <komut> | rm <id> | boş: geri): ");
+            fflush(stdout);
+            pthread_mutex_unlock(&g_ui_mutex);
+
+            if (fgets(options_buffer, sizeof(options_buffer), stdin) != NULL)
+            {
+                // Satırı argümanlara ayır, cron ifadesi çift tırnak içinde verilebilir
+                char *sched_argv[32];
+                int sched_argc = 0;
+                char *cursor = options_buffer;
+                cursor[strcspn(cursor, "\n")] = '\0';
+                while (*cursor != '\0' && sched_argc < 32)
+                {
+                    while (*cursor == ' ' || *cursor == '\t')
+                        cursor++;
+                    if (*cursor == '\0')
+                        break;
+                    if (*cursor == '"')
+                    {
+                        sched_argv[sched_argc++] = ++cursor;
+                        cursor += strcspn(cursor, "\"");
+                    }
+                    else
+                    {
+                        sched_argv[sched_argc++] = cursor;
+                        cursor += strcspn(cursor, " \t");
+                    }
+                    if (*cursor != '\0')
+                        *cursor++ = '\0';
+                }
+
+                if (sched_argc >= 2 && strcmp(sched_argv[0], "add") == 0)
+                {
+                    unsigned int id = schedule_add(sched_argc - 1, sched_argv + 1);
+                    if (id != 0)
+                        printf("[SCHEDULE] Görev #%u eklendi.\n", id);
+                }
+                else if (sched_argc == 2 && strcmp(sched_argv[0], "rm") == 0)
+                {
+                    if (schedule_remove((unsigned int)strtoul(sched_argv[1], NULL, 10)) == 0)
+                        printf("[SCHEDULE] Görev #%s silindi.\n", sched_argv[1]);
+                    else
+                        fprintf(stderr, "[HATA] Görev #%s bulunamadı.\n", sched_argv[1]);
+                }
+            }
+            break;
         case 0: // Çıkış
             g_shutdown = 1;
             break;
@@ -906,8 +6239,15 @@ int main(int argc, char const *argv[])
     // Shutdown: thread sonlandırma ve temiz çıkış
     pthread_cancel(monitor_thread);
     pthread_cancel(ipc_thread);
+    pthread_cancel(loop_thread);
     pthread_join(monitor_thread, NULL);
     pthread_join(ipc_thread, NULL);
+    pthread_join(loop_thread, NULL);
+    for (int i = 0; i < SPAWNER_THREADS; i++)
+    {
+        pthread_cancel(spawner_threads[i]);
+        pthread_join(spawner_threads[i], NULL);
+    }
 
     clean_exit();
     return 0;
@@ -0,0 +1,67 @@
+#!/bin/bash
+# procx wait çıkış kodu testi: bilinen çıkış kodu aynen dönmeli, sahibi toplayamadan
+# ölen bir instance'ın process'i için WAIT_STATUS_UNKNOWN (255) dönmeli.
+# Kullanım: tests/wait_status.sh [procx yolu]   (make test)
+
+PROCX=$(realpath "${1:-./procx}")
+DOMAIN="test$$"
+TMP=$(mktemp -d)
+FAILED=0
+
+procx() { PROCX_PSI=off "$PROCX" --domain "$DOMAIN" "$@"; }
+
+cleanup()
+{
+    exec 3>&- 4>&-
+    [ -n "$A" ] && kill -9 "$A" 2>/dev/null
+    [ -n "$B" ] && kill -9 "$B" 2>/dev/null
+    wait 2>/dev/null
+    procx clean --force >/dev/null 2>&1
+    rm -rf "$TMP"
+}
+trap cleanup EXIT
+
+# Instance'lar menüyü okuduğu stdin kapanınca çıkar; fifo'ları açık tut
+start_instance()
+{
+    mkfifo "$TMP/$1"
+    PROCX_PSI=off "$PROCX" --domain "$DOMAIN" < "$TMP/$1" > "$TMP/$1.log" 2>&1 &
+}
+
+wait_instances()
+{
+    for _ in $(seq 50); do
+        procx ls --json | grep -q "\"instances\":$1," && return 0
+        sleep 0.1
+    done
+    echo "instance sayısı $1 olmadı"
+    exit 1
+}
+
+check()
+{
+    if [ "$2" -eq "$3" ]; then
+        echo "OK   $1 ($2)"
+    else
+        echo "FAIL $1: beklenen $3, gelen $2"
+        FAILED=1
+    fi
+}
+
+start_instance a; A=$!; exec 3>"$TMP/a"
+wait_instances 1
+start_instance b; B=$!; exec 4>"$TMP/b"
+wait_instances 2
+
+# procx run isteği ilk kayıtlı instance'a (A) gider, process'i A toplar
+PID=$(procx run sh -c 'sleep 0.5; exit 7')
+procx wait "$PID"
+check "bilinen çıkış kodu" $? 7
+
+# A ölünce process'i kimse toplayamaz; B sonlandığını görür ama durumu bilmez
+PID=$(procx run sleep 1)
+kill -9 "$A"; wait "$A" 2>/dev/null; A=
+procx wait "$PID" 2>/dev/null
+check "bilinmeyen çıkış durumu" $? 255
+
+exit $FAILED